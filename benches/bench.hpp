@@ -0,0 +1,255 @@
+// Glarens - GUI Framework.
+//
+// Minimal benchmark harness with JSON output.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifndef GLARENS_BENCH_SUITE
+#define GLARENS_BENCH_SUITE "unnamed"
+#endif
+
+#ifndef GLARENS_VERSION
+#define GLARENS_VERSION "unknown"
+#endif
+
+/// Keeps the compiler from discarding a computed value
+template <typename T>
+inline void bench_keep(const T &value) {
+#ifdef _MSC_VER
+    static volatile const void *sink;
+    sink = &value;
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/// Timings of one benchmark at one size
+struct BenchResult {
+    std::string name;
+    std::size_t size       = 0;
+    std::size_t samples    = 0;
+    std::size_t iterations = 0; /// Operations per sample
+    double      minNs      = 0.0;
+    double      medianNs   = 0.0;
+    double      meanNs     = 0.0;
+};
+
+/// Handed to a benchmark body, which prepares its data and then measures one operation
+class BenchState {
+    using Clock = std::chrono::steady_clock;
+
+    double minTime_;
+    double sampleTime_;
+
+    std::vector<double> perOp_; /// Nanoseconds per operation of each sample
+    std::size_t         iterations_ = 1;
+
+    void add_sample_(Clock::duration elapsed, std::size_t iterations) {
+        perOp_.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations));
+    }
+
+    [[nodiscard]] bool done_(Clock::time_point start) const {
+        double total = std::chrono::duration<double>(Clock::now() - start).count();
+        return perOp_.size() >= MAX_SAMPLES || (perOp_.size() >= MIN_SAMPLES && total >= minTime_);
+    }
+
+  public:
+    static constexpr std::size_t MIN_SAMPLES = 5;
+    static constexpr std::size_t MAX_SAMPLES = 1000;
+
+    const std::size_t size; /// Problem size the body was registered with, 0 if none
+
+    BenchState(std::size_t size, double minTime) noexcept : minTime_(minTime), sampleTime_(minTime / 50.0), size(size) {}
+
+    /// Times the operation, repeating it within a sample until the sample is long enough to time reliably
+    template <typename Fn>
+    void measure(Fn &&fn) {
+        // Warm up and find the number of operations per sample
+        std::size_t iterations = 1;
+        while (true) {
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < iterations; i++) {
+                fn();
+            }
+
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            if (elapsed >= sampleTime_ || iterations >= (std::size_t(1) << 30)) {
+                break;
+            }
+            iterations *= 2;
+        }
+
+        iterations_ = iterations;
+        perOp_.clear();
+
+        auto begin = Clock::now();
+        while (!done_(begin)) {
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < iterations; i++) {
+                fn();
+            }
+            add_sample_(Clock::now() - start, iterations);
+        }
+    }
+
+    /// Times the operation once per sample, running the untimed setup before each
+    template <typename Setup, typename Fn>
+    void measure(Setup &&setup, Fn &&fn) {
+        setup();
+        fn();
+
+        iterations_ = 1;
+        perOp_.clear();
+
+        auto begin = Clock::now();
+        while (!done_(begin)) {
+            setup();
+            auto start = Clock::now();
+            fn();
+            add_sample_(Clock::now() - start, 1);
+        }
+    }
+
+    [[nodiscard]] BenchResult get_result(std::string name) const {
+        BenchResult result;
+        result.name       = std::move(name);
+        result.size       = size;
+        result.samples    = perOp_.size();
+        result.iterations = iterations_;
+        if (perOp_.empty()) {
+            return result;
+        }
+
+        std::vector<double> sorted = perOp_;
+        std::sort(sorted.begin(), sorted.end());
+
+        double sum = 0.0;
+        for (double ns : sorted) {
+            sum += ns;
+        }
+
+        result.minNs    = sorted.front();
+        result.medianNs = sorted[sorted.size() / 2];
+        result.meanNs   = sum / static_cast<double>(sorted.size());
+        return result;
+    }
+};
+
+struct BenchCase {
+    std::string                       name;
+    std::vector<std::size_t>          sizes; /// Run once per size, or once with size 0 if empty
+    std::function<void(BenchState &)> body;
+};
+
+inline std::vector<BenchCase> &bench_registry() {
+    static std::vector<BenchCase> registry;
+    return registry;
+}
+
+inline bool bench_register(std::string name, std::vector<std::size_t> sizes, std::function<void(BenchState &)> body) {
+    bench_registry().push_back(BenchCase{std::move(name), std::move(sizes), std::move(body)});
+    return true;
+}
+
+#define GLARENS_BENCH_CAT_(a, b) a##b
+#define GLARENS_BENCH_CAT(a, b)  GLARENS_BENCH_CAT_(a, b)
+
+/// Registers a benchmark body run once per listed size, e.g. GLARENS_BENCH("layout/build", 1000, 10000)
+#define GLARENS_BENCH(name, ...)                                                                                                      \
+    static void GLARENS_BENCH_CAT(bench_body_, __LINE__)(BenchState & state);                                                         \
+    static const bool GLARENS_BENCH_CAT(bench_registered_, __LINE__) = bench_register(name, {__VA_ARGS__}, GLARENS_BENCH_CAT(bench_body_, __LINE__)); \
+    static void GLARENS_BENCH_CAT(bench_body_, __LINE__)(BenchState & state)
+
+/// Escapes the characters JSON strings cannot hold verbatim
+inline std::string bench_json_string(std::string_view text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out + "\"";
+}
+
+/// Runs the registered benchmarks and prints the results as JSON
+/// Arguments: [--out FILE] [--min-time SECONDS] [FILTER], where FILTER is a substring of the names to run
+inline int bench_main(int argc, char **argv) {
+    std::string      out;
+    std::string_view filter;
+    double           minTime = 0.5;
+
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg == "--out" && i + 1 < argc) {
+            out = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minTime = std::stod(argv[++i]);
+        } else {
+            filter = arg;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    for (const auto &bench : bench_registry()) {
+        if (bench.name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        std::vector<std::size_t> sizes = bench.sizes.empty() ? std::vector<std::size_t>{0} : bench.sizes;
+        for (std::size_t size : sizes) {
+            BenchState state(size, minTime);
+            bench.body(state);
+            results.push_back(state.get_result(bench.name));
+            std::fprintf(stderr, "%-40s %8zu %14.1f ns\n", bench.name.c_str(), size, results.back().medianNs);
+        }
+    }
+
+    std::string json = "{\n  \"suite\": " + bench_json_string(GLARENS_BENCH_SUITE) + ",\n  \"version\": " + bench_json_string(GLARENS_VERSION) + ",\n  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const BenchResult &r = results[i];
+        char               line[512];
+        std::snprintf(
+            line, sizeof(line),
+            "%s\n    {\"name\": %s, \"size\": %zu, \"samples\": %zu, \"iterations\": %zu, \"min_ns\": %.3f, \"median_ns\": %.3f, \"mean_ns\": %.3f}",
+            i == 0 ? "" : ",", bench_json_string(r.name).c_str(), r.size, r.samples, r.iterations, r.minNs, r.medianNs, r.meanNs
+        );
+        json += line;
+    }
+    json += "\n  ]\n}\n";
+
+    if (out.empty()) {
+        std::fputs(json.c_str(), stdout);
+        return 0;
+    }
+
+    std::FILE *file = std::fopen(out.c_str(), "w");
+    if (!file) {
+        std::fprintf(stderr, "Cannot write %s\n", out.c_str());
+        return 1;
+    }
+
+    std::fputs(json.c_str(), file);
+    std::fclose(file);
+    return 0;
+}
+
+#ifdef GLARENS_BENCH_IMPLEMENT_MAIN
+int main(int argc, char **argv) {
+    return bench_main(argc, argv);
+}
+#endif
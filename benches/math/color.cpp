@@ -0,0 +1,69 @@
+// Glarens - GUI Framework.
+//
+// Color conversion and blending benchmarks.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "bench.hpp"
+#include "glarens/math.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Spread of colors over the RGB cube with varying alpha
+static std::vector<Color> palette() {
+    std::vector<Color> colors;
+    for (std::uint32_t i = 0; i < 1024; i++) {
+        colors.push_back(Color(static_cast<std::uint32_t>(i * 2654435761u)));
+    }
+    return colors;
+}
+
+/// Measures fn over the palette, one color per operation
+template <typename Fn>
+static void measure_palette(BenchState &state, Fn &&fn) {
+    auto        colors = palette();
+    std::size_t next   = 0;
+    state.measure([&] {
+        next++;
+        bench_keep(fn(colors[next & 1023], colors[(next * 7) & 1023]));
+    });
+}
+
+GLARENS_BENCH("color/to_linear") {
+    measure_palette(state, [](Color a, Color) { return a.to_linear(); });
+}
+
+GLARENS_BENCH("color/from_linear") {
+    measure_palette(state, [](Color a, Color) { return Color::from_linear(Vec4(Color::to_norm(a.r), Color::to_norm(a.g), Color::to_norm(a.b), Color::to_norm(a.a))); });
+}
+
+GLARENS_BENCH("color/hsv_round_trip") {
+    measure_palette(state, [](Color a, Color) { return Color::from_hsv(a.to_hsv()); });
+}
+
+GLARENS_BENCH("color/hsl_round_trip") {
+    measure_palette(state, [](Color a, Color) { return Color::from_hsl(a.to_hsl()); });
+}
+
+GLARENS_BENCH("color/oklch_round_trip") {
+    measure_palette(state, [](Color a, Color) { return Color::from_oklch(a.to_oklch()); });
+}
+
+GLARENS_BENCH("color/add") {
+    measure_palette(state, [](Color a, Color b) { return a + b; });
+}
+
+GLARENS_BENCH("color/multiply") {
+    measure_palette(state, [](Color a, Color b) { return a * b; });
+}
+
+GLARENS_BENCH("color/lerp_linear") {
+    measure_palette(state, [](Color a, Color b) { return Color::from_linear(lerp(a.to_linear(), b.to_linear(), 0.25f)); });
+}
+
+GLARENS_BENCH("color/lerp_oklab") {
+    measure_palette(state, [](Color a, Color b) { return Color::from_oklab(lerp(a.to_oklab(), b.to_oklab(), 0.25f)); });
+}
@@ -0,0 +1,34 @@
+// Glarens - GUI Framework.
+//
+// Flat node storage benchmarks.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "bench.hpp"
+#include "tree.hpp"
+#include <cstddef>
+#include <memory>
+
+// Same workload as layout/relayout_all, streamed through the arena instead of the recursive flush
+
+GLARENS_BENCH("arena/relayout_all", 1000, 10000, 100000) {
+    HeadlessScope headless;
+
+    auto root = build_tree(state.size);
+    root->flush_layout();
+
+    NodeArena arena;
+    arena.build(root);
+
+    LayoutContext context = LayoutContext::capture();
+    float         scale   = 1.0f;
+    state.measure([&] {
+        scale = scale == 1.0f ? 0.9f : 1.0f;
+        root->set_model(BoxModel(Vec2(), Vec2(), Vec2(), Vec2(), Vec2(scale, scale)));
+        arena.update_models();
+        arena.layout(context);
+        arena.commit();
+    });
+}
@@ -0,0 +1,57 @@
+// Glarens - GUI Framework.
+//
+// Cloning and synchronization benchmarks.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "bench.hpp"
+#include "tree.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+GLARENS_BENCH("clone/subtree", 10, 100, 1000) {
+    auto proto = build_tree(state.size);
+
+    std::shared_ptr<Node> clone;
+    state.measure([&] { clone.reset(); }, [&] { clone = proto->clone(); });
+}
+
+GLARENS_BENCH("clone/instantiate", 100, 1000, 10000) {
+    auto proto = build_tree(10);
+
+    std::shared_ptr<Node> parent;
+    state.measure([&] { parent = Node::create(); }, [&] {
+        bench_keep(instantiate(proto, state.size, parent));
+        parent->flush_layout();
+    });
+}
+
+GLARENS_BENCH("clone/sync_fan_out", 100, 1000, 10000) {
+    auto proto = build_tree(10);
+
+    std::vector<std::shared_ptr<Node>> clones;
+    for (std::size_t i = 0; i < state.size; i++) {
+        clones.push_back(proto->clone());
+    }
+
+    BoxModel model = proto->get_model();
+    state.measure([&] {
+        model.pos.x = -model.pos.x + 1.0f;
+        proto->set_model(model);
+        proto->sync_clones();
+    });
+}
+
+GLARENS_BENCH("clone/sync_unchanged", 100, 1000, 10000) {
+    auto proto = build_tree(10);
+
+    std::vector<std::shared_ptr<Node>> clones;
+    for (std::size_t i = 0; i < state.size; i++) {
+        clones.push_back(proto->clone());
+    }
+
+    state.measure([&] { proto->sync_clones(); });
+}
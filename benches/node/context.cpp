@@ -0,0 +1,82 @@
+// Glarens - GUI Framework.
+//
+// Context lookup benchmarks.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "bench.hpp"
+#include "tree.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class Theme : public Context {
+  public:
+    int value = 0;
+
+    static std::shared_ptr<Theme> create(int value) {
+        auto theme   = std::shared_ptr<Theme>(new Theme);
+        theme->value = value;
+        return theme;
+    }
+
+    std::shared_ptr<Context> clone() override {
+        return create(value);
+    }
+
+    void sync(const std::shared_ptr<Context> &proto) override {
+        value = std::static_pointer_cast<Theme>(proto)->value;
+    }
+};
+
+/// Chain of depth nodes with the context at the top, returning the bottom
+static std::shared_ptr<Node> build_chain(std::shared_ptr<Node> &root, std::size_t depth) {
+    root = Node::create();
+    root->set_context(Theme::create(1));
+
+    auto node = root;
+    for (std::size_t i = 1; i < depth; i++) {
+        node = node->create_child();
+    }
+    return node;
+}
+
+GLARENS_BENCH("context/ancestor_lookup", 10, 100, 1000) {
+    std::shared_ptr<Node> root;
+    auto                  leaf = build_chain(root, state.size);
+
+    state.measure([&] { bench_keep(leaf->get_context_in_ancestor<Theme>()); });
+}
+
+GLARENS_BENCH("context/ancestor_lookup_churn", 10, 100, 1000) {
+    std::shared_ptr<Node> root;
+    auto                  leaf = build_chain(root, state.size);
+
+    // Nodes coming and going elsewhere in the tree keep the lookup cached
+    state.measure([&] {
+        auto sibling = root->create_child();
+        root->remove_child(sibling);
+        bench_keep(leaf->get_context_in_ancestor<Theme>());
+    });
+}
+
+GLARENS_BENCH("context/ancestor_lookup_cold", 10, 100, 1000) {
+    std::shared_ptr<Node> root;
+    auto                  leaf = build_chain(root, state.size);
+
+    // Replacing the context invalidates the cached lookups below it
+    state.measure([&] { root->set_context(Theme::create(2)); }, [&] { bench_keep(leaf->get_context_in_ancestor<Theme>()); });
+}
+
+GLARENS_BENCH("context/descendant_count", 1000, 10000, 100000) {
+    std::vector<std::shared_ptr<Node>> nodes;
+    auto                               root   = build_tree(state.size, &nodes);
+    auto                               leaves = leaves_of(nodes);
+    for (std::size_t i = 0; i < leaves.size(); i += 4) {
+        leaves[i]->set_context(Theme::create(0));
+    }
+
+    state.measure([&] { bench_keep(root->count_context_in_descendant<Theme>()); });
+}
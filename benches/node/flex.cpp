@@ -0,0 +1,85 @@
+// Glarens - GUI Framework.
+//
+// Flex layout benchmarks.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "bench.hpp"
+#include "tree.hpp"
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+/// Wrapping flex layout of fixed and growing items with random bases
+static std::shared_ptr<FlexLayout> build_flex(std::size_t count, std::vector<std::shared_ptr<Node>> *items = nullptr) {
+    std::minstd_rand                      rng(7);
+    std::uniform_real_distribution<float> extent(8.0f, 64.0f);
+
+    auto layout = FlexLayout::create();
+    layout->set_model(BoxModel(Vec2(), Vec2(), Vec2(), Vec2(), Vec2(1.0f, 1.0f)));
+    layout->set_align(ALIGN_SPACE_AROUND);
+
+    for (std::size_t i = 0; i < count; i++) {
+        auto item = layout->create_child();
+        item->set_model(BoxModel(Vec2(), Vec2(), Vec2(), Vec2(extent(rng), extent(rng)), Vec2()));
+        if (rng() % 2 == 0) {
+            auto flex = FlexItem::create();
+            flex->set_weight(1.0f);
+            item->set_context(flex);
+        }
+
+        if (items) {
+            items->push_back(item);
+        }
+    }
+    return layout;
+}
+
+GLARENS_BENCH("layout/flex_resize", 10000) {
+    HeadlessScope headless;
+
+    auto layout = build_flex(state.size);
+    layout->flush_layout();
+
+    // Every line is rebuilt and every item re-modeled
+    float scale = 1.0f;
+    state.measure([&] {
+        scale = scale == 1.0f ? 0.9f : 1.0f;
+        layout->set_model(BoxModel(Vec2(), Vec2(), Vec2(), Vec2(), Vec2(scale, scale)));
+        layout->flush_layout();
+    });
+}
+
+GLARENS_BENCH("layout/flex_item", 10000) {
+    HeadlessScope headless;
+
+    std::vector<std::shared_ptr<Node>> items;
+    auto                               layout = build_flex(state.size, &items);
+    layout->flush_layout();
+
+    // One basis changes, shifting the items after it
+    std::size_t next = 0;
+    state.measure([&] {
+        const auto &item  = items[next++ % items.size()];
+        BoxModel    model = item->get_model();
+        model.size.x += 1.0f;
+        item->set_model(model);
+        layout->flush_layout();
+    });
+}
+
+GLARENS_BENCH("layout/flex_steady", 10000) {
+    HeadlessScope headless;
+
+    auto layout = build_flex(state.size);
+    layout->flush_layout();
+
+    // Nothing moves, so no item is re-modeled
+    state.measure([&] {
+        layout->refresh_layout();
+        layout->flush_layout();
+    });
+}
@@ -0,0 +1,66 @@
+// Glarens - GUI Framework.
+//
+// Grid layout benchmarks.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "bench.hpp"
+#include "tree.hpp"
+#include <cstddef>
+#include <memory>
+#include <random>
+
+/// Masonry wall of items with random heights, some spanning two slots
+static std::shared_ptr<GridLayout> build_wall(std::size_t count) {
+    std::minstd_rand                      rng(11);
+    std::uniform_real_distribution<float> height(40.0f, 240.0f);
+
+    auto wall = GridLayout::create();
+    wall->set_model(BoxModel(Vec2(), Vec2(), Vec2(), Vec2(), Vec2(1.0f, 1.0f)));
+    wall->set_slots(6);
+    wall->set_masonry(true);
+
+    for (std::size_t i = 0; i < count; i++) {
+        auto item = wall->create_child();
+        item->set_model(BoxModel(Vec2(), Vec2(), Vec2(), Vec2(0.0f, height(rng)), Vec2()));
+        if (rng() % 8 == 0) {
+            auto grid = GridItem::create();
+            grid->set_x_span(2);
+            item->set_context(grid);
+        }
+    }
+    return wall;
+}
+
+GLARENS_BENCH("layout/grid_append", 1000, 10000, 100000) {
+    HeadlessScope headless;
+
+    auto wall = build_wall(state.size);
+    wall->flush_layout();
+
+    // Placing the appended item and dropping it again leaves the others in place
+    state.measure([&] {
+        auto item = wall->create_child();
+        item->set_model(BoxModel(Vec2(), Vec2(), Vec2(), Vec2(0.0f, 120.0f), Vec2()));
+        wall->flush_layout();
+        wall->remove_child(item);
+        wall->flush_layout();
+    });
+}
+
+GLARENS_BENCH("layout/grid_resize", 10000) {
+    HeadlessScope headless;
+
+    auto wall = build_wall(state.size);
+    wall->flush_layout();
+
+    // Every item is packed again
+    float scale = 1.0f;
+    state.measure([&] {
+        scale = scale == 1.0f ? 0.9f : 1.0f;
+        wall->set_model(BoxModel(Vec2(), Vec2(), Vec2(), Vec2(), Vec2(scale, 1.0f)));
+        wall->flush_layout();
+    });
+}
@@ -0,0 +1,73 @@
+// Glarens - GUI Framework.
+//
+// Layout benchmarks.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "bench.hpp"
+#include "tree.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+GLARENS_BENCH("layout/build", 1000, 10000, 100000) {
+    HeadlessScope headless;
+
+    std::shared_ptr<Node> root;
+    state.measure([&] { root.reset(); }, [&] {
+        root = build_tree(state.size);
+        root->flush_layout();
+    });
+}
+
+GLARENS_BENCH("layout/relayout_all", 1000, 10000, 100000) {
+    HeadlessScope headless;
+
+    auto root = build_tree(state.size);
+    root->flush_layout();
+
+    // Resizing the root changes the reference metric of every node
+    float scale = 1.0f;
+    state.measure([&] {
+        scale = scale == 1.0f ? 0.9f : 1.0f;
+        root->set_model(BoxModel(Vec2(), Vec2(), Vec2(), Vec2(), Vec2(scale, scale)));
+        root->flush_layout();
+    });
+}
+
+GLARENS_BENCH("layout/relayout_leaf", 1000, 10000, 100000) {
+    HeadlessScope headless;
+
+    std::vector<std::shared_ptr<Node>> nodes;
+    auto                               root   = build_tree(state.size, &nodes);
+    auto                               leaves = leaves_of(nodes);
+    root->flush_layout();
+
+    std::size_t next = 0;
+    state.measure([&] {
+        const auto &leaf  = leaves[next++ % leaves.size()];
+        BoxModel    model = leaf->get_model();
+        model.pos.x       = -model.pos.x;
+        leaf->set_model(model);
+        root->flush_layout();
+    });
+}
+
+GLARENS_BENCH("layout/relayout_parallel", 10000, 100000) {
+    HeadlessScope headless;
+    glarens_set_layout_threads(4);
+
+    auto root = build_tree(state.size);
+    root->flush_layout();
+
+    float scale = 1.0f;
+    state.measure([&] {
+        scale = scale == 1.0f ? 0.9f : 1.0f;
+        root->set_model(BoxModel(Vec2(), Vec2(), Vec2(), Vec2(), Vec2(scale, scale)));
+        root->flush_layout();
+    });
+
+    glarens_set_layout_threads(0);
+}
@@ -0,0 +1,11 @@
+// Glarens - GUI Framework.
+//
+// Node benchmark entry point.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#define GLARENS_BENCH_IMPLEMENT_MAIN
+
+#include "bench.hpp"
@@ -0,0 +1,95 @@
+// Glarens - GUI Framework.
+//
+// Hit testing and picking benchmarks.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "bench.hpp"
+#include "tree.hpp"
+#include "glarens/spatial-index.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/// Positions on a regular grid over the viewport
+static std::vector<Vec2> sweep_points() {
+    std::vector<Vec2> points;
+    for (float y = 0.0f; y < 720.0f; y += 45.0f) {
+        for (float x = 0.0f; x < 1280.0f; x += 80.0f) {
+            points.push_back(Vec2(x, y));
+        }
+    }
+    return points;
+}
+
+/// Hit tests every node, keeping the last hit as a linear scan in render order would
+static const Node *pick_linear(const std::vector<std::shared_ptr<Node>> &nodes, Vec2 position) {
+    const Node *hit = nullptr;
+    for (const auto &node : nodes) {
+        if (node->hit_test(position)) {
+            hit = node.get();
+        }
+    }
+    return hit;
+}
+
+GLARENS_BENCH("hit_test/sweep_linear", 1000, 10000, 100000) {
+    HeadlessScope headless;
+
+    std::vector<std::shared_ptr<Node>> nodes;
+    auto                               root = build_tree(state.size, &nodes);
+    root->debug();
+
+    auto        points = sweep_points();
+    std::size_t next   = 0;
+    state.measure([&] { bench_keep(pick_linear(nodes, points[next++ % points.size()])); });
+}
+
+GLARENS_BENCH("hit_test/sweep_indexed", 1000, 10000, 100000) {
+    HeadlessScope headless;
+
+    auto root = build_tree(state.size);
+    root->debug();
+
+    SpatialIndex index;
+    index.build(root);
+
+    auto        points = sweep_points();
+    std::size_t next   = 0;
+    state.measure([&] { bench_keep(index.pick(points[next++ % points.size()])); });
+}
+
+GLARENS_BENCH("hit_test/index_build", 1000, 10000, 100000) {
+    HeadlessScope headless;
+
+    auto root = build_tree(state.size);
+    root->debug();
+
+    state.measure([&] {
+        SpatialIndex index;
+        index.build(root);
+        bench_keep(index.size());
+    });
+}
+
+GLARENS_BENCH("hit_test/index_refit_one", 1000, 10000, 100000) {
+    HeadlessScope headless;
+
+    std::vector<std::shared_ptr<Node>> nodes;
+    auto                               root = build_tree(state.size, &nodes);
+    root->debug();
+
+    SpatialIndex index;
+    index.build(root);
+
+    // Only the moved leaf is re-read, whatever the size of the tree
+    BoxModel model = nodes.back()->get_model();
+    state.measure([&] {
+        model.pos.x = model.pos.x == 0.0f ? 10.0f : 0.0f;
+        nodes.back()->set_model(model);
+        root->flush_layout();
+        bench_keep(index.refit());
+    });
+}
@@ -0,0 +1,105 @@
+// Glarens - GUI Framework.
+//
+// Synthetic node trees for benchmarks.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#pragma once
+
+#include "glarens/glarens.hpp" // IWYU pragma: export
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+/// Headless library state for the duration of a benchmark
+struct HeadlessScope {
+    HeadlessScope() { glarens_init_headless(Vec2(1280.0f, 720.0f)); }
+
+    ~HeadlessScope() { glarens_term(); }
+};
+
+/// Model with a mix of absolute and relative dimensions, occasionally clamped
+inline BoxModel random_model(std::minstd_rand &rng) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> offset(-20.0f, 20.0f);
+
+    BoxModel model;
+    model.pos    = Vec2(offset(rng), offset(rng));
+    model.anchor = Vec2(unit(rng) - 0.5f, unit(rng) - 0.5f);
+    model.size   = Vec2(unit(rng) * 40.0f, unit(rng) * 40.0f);
+    model.scale  = Vec2(unit(rng) * 0.5f, unit(rng) * 0.5f);
+
+    if (rng() % 8 == 0) {
+        model.sizingRefMode = REF_MODE_ABSOLUTE;
+    }
+
+    if (rng() % 4 == 0) {
+        BoxDim min;
+        min.size  = Vec2(8.0f, 8.0f);
+        model.min = min;
+    }
+    return model;
+}
+
+/// Empty for most nodes, otherwise one or two offsets, rotations and scales
+inline TStack random_t_stack(std::minstd_rand &rng) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    TStack stack;
+    if (rng() % 4 != 0) {
+        return stack;
+    }
+
+    std::size_t count = 1 + rng() % 2;
+    for (std::size_t i = 0; i < count; i++) {
+        Transformation t;
+        t.originAnchor = Vec2(unit(rng) - 0.5f, unit(rng) - 0.5f);
+        t.offset       = Vec2(unit(rng) * 10.0f, unit(rng) * 10.0f);
+        t.rotate       = unit(rng) * 0.5f;
+        t.scale        = Vec2(0.75f + unit(rng) * 0.5f, 0.75f + unit(rng) * 0.5f);
+        stack.push_back(t);
+    }
+    return stack;
+}
+
+/// Tree of count nodes with 2 to 8 children per inner node, deterministic for a seed
+/// Nodes are appended to the output vector in breadth-first order if given
+inline std::shared_ptr<Node> build_tree(std::size_t count, std::vector<std::shared_ptr<Node>> *nodes = nullptr, unsigned seed = 1) {
+    std::minstd_rand rng(seed);
+
+    auto root = Node::create();
+    root->set_model(BoxModel(Vec2(), Vec2(), Vec2(), Vec2(), Vec2(1.0f, 1.0f)));
+
+    std::vector<std::shared_ptr<Node>> frontier{root};
+    std::size_t                        built = 1;
+    for (std::size_t i = 0; built < count; i++) {
+        auto parent = frontier[i];
+
+        std::size_t fanOut = 2 + rng() % 7;
+        for (std::size_t j = 0; j < fanOut && built < count; j++, built++) {
+            auto child = parent->create_child();
+            child->set_model(random_model(rng));
+            child->set_t_stack(random_t_stack(rng));
+            frontier.push_back(child);
+        }
+    }
+
+    if (nodes) {
+        nodes->insert(nodes->end(), frontier.begin(), frontier.end());
+    }
+    return root;
+}
+
+/// Nodes without children
+inline std::vector<std::shared_ptr<Node>> leaves_of(const std::vector<std::shared_ptr<Node>> &nodes) {
+    std::vector<std::shared_ptr<Node>> leaves;
+    for (const auto &node : nodes) {
+        if (node->get_subtree_size() == 1) {
+            leaves.push_back(node);
+        }
+    }
+    return leaves;
+}
@@ -35,6 +35,7 @@ SDL_AppResult SDL_AppInit(void **, int argc, char *argv[]) {
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
     glarens_init(window, renderer);
+    glarens_set_partial_redraw(true);
 
     root = Node::create();
 
@@ -71,10 +72,7 @@ SDL_AppResult SDL_AppEvent(void *, SDL_Event *event) {
 }
 
 SDL_AppResult SDL_AppIterate(void *) {
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer);
-
-    root->debug();
+    glarens_render(root, Color(0x000000FFu), true);
 
     SDL_RenderPresent(renderer);
 
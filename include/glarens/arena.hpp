@@ -0,0 +1,75 @@
+// Glarens - GUI Framework.
+//
+// Flat node storage.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#pragma once
+
+#include "glarens/node.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+/// Structure-of-arrays snapshot of a node tree in depth-first order
+/// Parents always precede their descendants, so passes can stream through the arrays linearly
+/// Note: nodes remain the owners of their data; the arena mirrors it until rebuilt
+class NodeArena {
+    std::vector<const Node *> nodes_;
+    std::vector<BoxModel>     models_;
+    std::vector<TStack>       tStacks_;
+    std::vector<bool>         lazy_;
+    std::vector<BoxMetric>    mMetrics_;
+    std::vector<BoxMetric>    tMetrics_;
+    std::vector<BoxMetric>    childRefs_;
+
+    std::vector<std::uint32_t> parents_;
+    std::vector<std::uint32_t> firstChildren_;
+    std::vector<std::uint32_t> nextSiblings_;
+    std::vector<std::uint32_t> subtreeSizes_;
+
+  public:
+    static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max(); /// Missing index
+
+    /// Snapshots the hierarchy, models and transformations of the tree
+    void build(const std::shared_ptr<Node> &root);
+
+    /// Re-reads the models and transformation stacks invalidated since the last commit, without rebuilding the hierarchy
+    /// Note: nodes flushed outside of the arena in the meantime need a rebuild
+    void update_models();
+
+    /// Recomputes every metric in a single linear pass
+    /// Note: on_model overrides run in tree order, before the metrics of their children
+    void layout(const LayoutContext &context);
+
+    /// Writes the computed metrics back to the nodes
+    void commit() const;
+
+    void clear() noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept { return nodes_.size(); }
+
+    [[nodiscard]] const std::vector<const Node *> &get_nodes() const noexcept { return nodes_; }
+
+    [[nodiscard]] const std::vector<BoxModel> &get_models() const noexcept { return models_; }
+
+    [[nodiscard]] const std::vector<BoxMetric> &get_m_metrics() const noexcept { return mMetrics_; }
+
+    [[nodiscard]] const std::vector<BoxMetric> &get_t_metrics() const noexcept { return tMetrics_; }
+
+    /// Reference metric each node provides to its children
+    [[nodiscard]] const std::vector<BoxMetric> &get_child_references() const noexcept { return childRefs_; }
+
+    [[nodiscard]] const std::vector<std::uint32_t> &get_parents() const noexcept { return parents_; }
+
+    [[nodiscard]] const std::vector<std::uint32_t> &get_first_children() const noexcept { return firstChildren_; }
+
+    [[nodiscard]] const std::vector<std::uint32_t> &get_next_siblings() const noexcept { return nextSiblings_; }
+
+    /// Number of nodes in each subtree, including its root
+    [[nodiscard]] const std::vector<std::uint32_t> &get_subtree_sizes() const noexcept { return subtreeSizes_; }
+};
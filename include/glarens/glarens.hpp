@@ -8,10 +8,73 @@
 
 #pragma once
 
-#include "glarens/math.hpp" // IWYU pragma: keep
-#include "glarens/node.hpp" // IWYU pragma: keep
+#include "glarens/arena.hpp"         // IWYU pragma: keep
+#include "glarens/layout.hpp"        // IWYU pragma: keep
+#include "glarens/math.hpp"          // IWYU pragma: keep
+#include "glarens/node.hpp"          // IWYU pragma: keep
+#include "glarens/profiler.hpp"      // IWYU pragma: keep
+#include "glarens/render-batch.hpp"  // IWYU pragma: keep
+#include "glarens/spatial-index.hpp" // IWYU pragma: keep
 #include <SDL3/SDL_render.h>
+#include <SDL3/SDL_surface.h>
 #include <SDL3/SDL_video.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
 
 void glarens_init(SDL_Window *window, SDL_Renderer *renderer); // Initializes Glarens
 void glarens_term();                                           // Terminates Glarens
+
+/// Initializes Glarens without a window, rendering with a software renderer into a surface of the viewport size
+/// Layout sees the virtual viewport and display scale in place of a window's, so metrics match a window of that size
+/// Returns false if the surface or renderer could not be created
+bool glarens_init_headless(Vec2 viewport, float dpiScale = 1.0f);
+
+/// Surface drawn into by the headless renderer, null unless initialized headless
+/// Note: call SDL_FlushRenderer before reading its pixels
+SDL_Surface *glarens_get_headless_surface();
+
+/// Lays out sibling subtrees on worker threads, serial for less than 2 threads
+/// Note: on_model overrides must only modify their own subtree while enabled
+void glarens_set_layout_threads(std::size_t threadCount);
+
+/// Minimum subtree size (in nodes) to be laid out on a worker thread
+void glarens_set_layout_threshold(std::size_t nodeCount);
+
+/// Keeps the previous frame in a backbuffer and redraws only the regions damaged since, see glarens_render()
+/// Note: damage comes from metric changes, inserts, removals and invalidate_render()
+void glarens_set_partial_redraw(bool enable);
+
+/// Marks the whole output as damaged, e.g. after drawing over it outside of Glarens
+void glarens_damage_all();
+
+/// Counts invalidations and layout recomputes per node, attributing forced recomputes of descendants to the invalidated node
+/// While enabled, debug() heat-maps nodes by cost instead of coloring them by identity
+void glarens_set_invalidation_tracking(bool enable);
+
+/// Tracked node and its accounting
+struct InvalidationOffender {
+    std::shared_ptr<const Node> node;
+    InvalidationStats           stats;
+};
+
+/// Tracked nodes with the most recomputes and touched descendants, costliest first
+[[nodiscard]] std::vector<InvalidationOffender> glarens_get_invalidation_offenders(std::size_t count = 10);
+
+/// Zeroes the accounting of every tracked node
+void glarens_reset_invalidation_stats();
+
+/// Limits the memory of layer textures, evicting the least recently composited ones (64 MiB by default)
+void glarens_set_layer_budget(std::size_t bytes);
+
+/// Memory of the layer textures currently cached, in bytes
+std::size_t glarens_get_layer_usage();
+
+/// Renders the tree to the current render target over the background color
+/// With partial redraw, the damaged region is redrawn into the backbuffer under a clip rect, then the backbuffer is copied
+/// Note: call SDL_RenderPresent afterwards
+void glarens_render(const std::shared_ptr<Node> &root, Color background, bool debug = false);
+
+/// Batch of the current render pass, for pre_render and post_render overrides
+/// Note: submitted when the outermost render() or debug() call returns
+[[nodiscard]] RenderBatch &glarens_get_batch();
@@ -9,8 +9,13 @@
 #pragma once
 
 #include "glarens/node.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 enum Align {
     ALIGN_BEGIN,  /// Align to the beginning of the axis
@@ -31,9 +36,13 @@ enum Direction {
     DIRECTION_RIGHT /// x+ direction
 };
 
-// Note: hildren without the corresponding Item context are treated as if the context exists with default values
+// Note: children without the corresponding Item context are treated as if the context exists with default values
 
-/// Arranges items linearly
+/// Arranges items linearly, wrapping them into lines
+/// Note: owns the models of its children. The model a child had before (or was last given by others) is its basis,
+/// resolved against this node; the placed slot is written back as an absolute model
+/// Note: weights grow items into the free space of their line, so align only applies to lines of zero total weight
+/// Items have zero weights unless given, so by default they keep their basis and are aligned
 class FlexLayout : public Node {
     Param<Direction> dir_     = DIRECTION_RIGHT;
     Param<Direction> wrapDir_ = DIRECTION_DOWN;
@@ -42,9 +51,33 @@ class FlexLayout : public Node {
     Param<Align> wrapAlign_ = ALIGN_BEGIN;
 
     Param<bool> doWrapping_  = true;
-    Param<bool> altWrapping_ = false;
-
-    void update_layout_();
+    Param<bool> altWrapping_ = false; /// Every other line runs in the opposite direction
+
+    struct Basis {
+        BoxModel      model;       /// Model of the child as given by others
+        std::uint64_t version = 0; /// Model version of the child after the layout wrote it
+    };
+
+    struct Item {
+        Basis *basis      = nullptr;
+        float  main       = 0.0f; /// Basis extent along the direction
+        float  cross      = 0.0f; /// Basis extent along the wrapping direction
+        float  weight     = 0.0f;
+        float  wrapWeight = 0.0f;
+    };
+
+    struct Line {
+        std::size_t first      = 0; /// Index of the first item
+        std::size_t count      = 0;
+        float       main       = 0.0f; /// Sum of the basis extents
+        float       cross      = 0.0f; /// Largest basis extent, then the grown extent of the line
+        float       weight     = 0.0f; /// Sum of the item weights
+        float       wrapWeight = 0.0f; /// Largest item wrap weight
+    };
+
+    mutable std::unordered_map<const Node *, Basis> bases_;
+    mutable std::vector<Item>                       items_; /// Reused across passes
+    mutable std::vector<Line>                       lines_;
 
   protected:
     FlexLayout() = default;
@@ -66,22 +99,70 @@ class FlexLayout : public Node {
 
         Node::sync(proto);
 
-        dir_.set_proto(layout->dir_.get());
-        wrapDir_.set_proto(layout->wrapDir_.get());
-        align_.set_proto(layout->align_.get());
-        wrapAlign_.set_proto(layout->wrapAlign_.get());
-        doWrapping_.set_proto(layout->doWrapping_.get());
-        altWrapping_.set_proto(layout->altWrapping_.get());
+        bool changed = false;
+        changed |= dir_.sync(layout->dir_);
+        changed |= wrapDir_.sync(layout->wrapDir_);
+        changed |= align_.sync(layout->align_);
+        changed |= wrapAlign_.sync(layout->wrapAlign_);
+        changed |= doWrapping_.sync(layout->doWrapping_);
+        changed |= altWrapping_.sync(layout->altWrapping_);
+        if (changed) {
+            refresh_layout();
+        }
+    }
+
+    [[nodiscard]] std::uint64_t get_params_version() const noexcept override {
+        return std::max({Node::get_params_version(), dir_.get_version(), wrapDir_.get_version(), align_.get_version(), wrapAlign_.get_version(), doWrapping_.get_version(), altWrapping_.get_version()});
+    }
+
+    [[nodiscard]] Direction get_dir() const { return dir_.get(); }
+    [[nodiscard]] Direction get_wrap_dir() const { return wrapDir_.get(); }
+    [[nodiscard]] Align     get_align() const { return align_.get(); }
+    [[nodiscard]] Align     get_wrap_align() const { return wrapAlign_.get(); }
+    [[nodiscard]] bool      get_wrapping() const { return doWrapping_.get(); }
+    [[nodiscard]] bool      get_alt_wrapping() const { return altWrapping_.get(); }
+
+    // Note: a wrapping direction along the direction falls back to the perpendicular one
+
+    void set_dir(Direction value) {
+        dir_.set(value);
+        refresh_layout();
+    }
+
+    void set_wrap_dir(Direction value) {
+        wrapDir_.set(value);
+        refresh_layout();
+    }
+
+    void set_align(Align value) {
+        align_.set(value);
+        refresh_layout();
+    }
+
+    void set_wrap_align(Align value) {
+        wrapAlign_.set(value);
+        refresh_layout();
+    }
+
+    void set_wrapping(bool value) {
+        doWrapping_.set(value);
+        refresh_layout();
+    }
+
+    void set_alt_wrapping(bool value) {
+        altWrapping_.set(value);
+        refresh_layout();
     }
 
-    void on_model() override;
+    /// Resolves every item and line in a single linear pass
+    void on_model(const LayoutContext &context) const override;
 };
 
-class FlexItem : public Context {
-    Param<float> weight_     = 1.0f;
-    Param<float> wrapWeight_ = 1.0f;
+// Note: call refresh_layout() on the layout after changing the item contexts of its children
 
-    void update_layout_();
+class FlexItem : public Context {
+    Param<float> weight_     = 0.0f; /// Share of the free space along the direction
+    Param<float> wrapWeight_ = 0.0f; /// Share of the free space along the wrapping direction, the largest in a line counts
 
   protected:
     FlexItem() = default;
@@ -103,23 +184,67 @@ class FlexItem : public Context {
             throw std::runtime_error("Prototype of a different type cannot be used to synchronize parameters");
         }
 
-        weight_.set_proto(context->weight_.get());
-        wrapWeight_.set_proto(context->wrapWeight_.get());
+        weight_.sync(context->weight_);
+        wrapWeight_.sync(context->wrapWeight_);
+    }
+
+    [[nodiscard]] float get_weight() const { return weight_.get(); }
+    [[nodiscard]] float get_wrap_weight() const { return wrapWeight_.get(); }
+
+    void set_weight(float value) { weight_.set(value); }
+    void set_wrap_weight(float value) { wrapWeight_.set(value); }
+
+    [[nodiscard]] std::uint64_t get_version() const noexcept override {
+        return std::max(weight_.get_version(), wrapWeight_.get_version());
     }
 };
 
-/// Arranges items in a grid
+class GridItem;
+
+/// Arranges items in a grid of slots along the direction, stacking them along the wrapping direction
+/// Note: owns the models of its children like FlexLayout; items span slots along the direction, and extend by their
+/// basis (or by their span of square slots without one) along the wrapping direction
+/// Note: rows of a regular grid start below the longest item of the previous row, masonry packs each item into the
+/// shortest slots instead. Either way, appending or removing items re-places only the items after the change
 class GridLayout : public Node {
     Param<Direction> dir_     = DIRECTION_RIGHT;
     Param<Direction> wrapDir_ = DIRECTION_DOWN;
 
-    Param<Align> align_     = ALIGN_BEGIN;
-    Param<Align> wrapAlign_ = ALIGN_BEGIN;
+    Param<Align> align_     = ALIGN_BEGIN; /// Alignment of items within their cells along the direction
+    Param<Align> wrapAlign_ = ALIGN_BEGIN; /// Alignment of items within their cells along the wrapping direction
 
     Param<int>  slots_   = 1;
     Param<bool> masonry_ = false;
 
-    void update_layout_();
+    struct Basis {
+        BoxModel      model;       /// Model of the child as given by others
+        std::uint64_t version = 0; /// Model version of the child after the layout wrote it
+        std::size_t   index   = 0; /// Position of the child when it was placed
+    };
+
+    struct Placement {
+        const Node     *child       = nullptr;
+        std::uint64_t   version     = 0; /// Model version of the child after it was placed
+        const GridItem *item        = nullptr;
+        std::uint64_t   itemVersion = 0;
+    };
+
+    /// Packing state before an item, the column heights are kept separately
+    struct Cursor {
+        std::size_t slot   = 0;    /// Next slot of the current row, regular grids only
+        float       rowTop = 0.0f; /// Start of the current row, regular grids only
+    };
+
+    mutable std::unordered_map<const Node *, Basis> bases_;
+    mutable std::vector<Placement>                  placements_;
+    mutable std::vector<Cursor>                     cursors_; /// One more than placements, the last is the final state
+    mutable std::vector<float>                      heights_; /// Column heights of each cursor, slots per cursor
+
+    mutable Vec2          placedExtent_;      /// Reference extent the placements were made against
+    mutable Vec2          placedViewport_;    /// Viewport the bases were resolved against
+    mutable std::uint64_t placedVersion_ = 0; /// Parameter version the placements were made with
+
+    [[nodiscard]] std::uint64_t get_params_version_() const noexcept;
 
   protected:
     GridLayout() = default;
@@ -141,24 +266,72 @@ class GridLayout : public Node {
 
         Node::sync(proto);
 
-        dir_.set_proto(layout->dir_.get());
-        wrapDir_.set_proto(layout->wrapDir_.get());
-        align_.set_proto(layout->align_.get());
-        wrapAlign_.set_proto(layout->wrapAlign_.get());
-        slots_.set_proto(layout->slots_.get());
-        masonry_.set_proto(layout->masonry_.get());
+        bool changed = false;
+        changed |= dir_.sync(layout->dir_);
+        changed |= wrapDir_.sync(layout->wrapDir_);
+        changed |= align_.sync(layout->align_);
+        changed |= wrapAlign_.sync(layout->wrapAlign_);
+        changed |= slots_.sync(layout->slots_);
+        changed |= masonry_.sync(layout->masonry_);
+        if (changed) {
+            refresh_layout();
+        }
     }
 
-    void on_model() override;
+    [[nodiscard]] std::uint64_t get_params_version() const noexcept override {
+        return std::max(Node::get_params_version(), get_params_version_());
+    }
+
+    [[nodiscard]] Direction get_dir() const { return dir_.get(); }
+    [[nodiscard]] Direction get_wrap_dir() const { return wrapDir_.get(); }
+    [[nodiscard]] Align     get_align() const { return align_.get(); }
+    [[nodiscard]] Align     get_wrap_align() const { return wrapAlign_.get(); }
+    [[nodiscard]] int       get_slots() const { return slots_.get(); }
+    [[nodiscard]] bool      get_masonry() const { return masonry_.get(); }
+
+    // Note: a wrapping direction along the direction falls back to the perpendicular one
+
+    void set_dir(Direction value) {
+        dir_.set(value);
+        refresh_layout();
+    }
+
+    void set_wrap_dir(Direction value) {
+        wrapDir_.set(value);
+        refresh_layout();
+    }
+
+    void set_align(Align value) {
+        align_.set(value);
+        refresh_layout();
+    }
+
+    void set_wrap_align(Align value) {
+        wrapAlign_.set(value);
+        refresh_layout();
+    }
+
+    void set_slots(int value) {
+        slots_.set(value);
+        refresh_layout();
+    }
+
+    void set_masonry(bool value) {
+        masonry_.set(value);
+        refresh_layout();
+    }
+
+    /// Places the items from the first one that changed since the previous pass
+    void on_model(const LayoutContext &context) const override;
 };
 
-class GridItem : public Context {
-    Param<int>   xSpan_   = 1;
-    Param<int>   ySpan_   = 1;
-    Param<float> xWeight_ = 1.0f;
-    Param<float> yWeight_ = 1.0f;
+// Note: call refresh_layout() on the layout after changing the item contexts of its children
 
-    void update_layout_();
+class GridItem : public Context {
+    Param<int>   xSpan_   = 1;    /// Slots spanned along the direction
+    Param<int>   ySpan_   = 1;    /// Square slots spanned along the wrapping direction, unless the basis has an extent
+    Param<float> xWeight_ = 1.0f; /// Share of the cell filled along the direction, the rest is aligned
+    Param<float> yWeight_ = 1.0f; /// Share of the cell filled along the wrapping direction, the rest is aligned
 
   protected:
     GridItem() = default;
@@ -180,10 +353,25 @@ class GridItem : public Context {
             throw std::runtime_error("Prototype of a different type cannot be used to synchronize parameters");
         }
 
-        xSpan_.set_proto(context->xSpan_.get());
-        ySpan_.set_proto(context->ySpan_.get());
-        xWeight_.set_proto(context->xWeight_.get());
-        yWeight_.set_proto(context->yWeight_.get());
+        xSpan_.sync(context->xSpan_);
+        ySpan_.sync(context->ySpan_);
+        xWeight_.sync(context->xWeight_);
+        yWeight_.sync(context->yWeight_);
+    }
+
+    [[nodiscard]] int   get_x_span() const { return xSpan_.get(); }
+    [[nodiscard]] int   get_y_span() const { return ySpan_.get(); }
+    [[nodiscard]] float get_x_weight() const { return xWeight_.get(); }
+    [[nodiscard]] float get_y_weight() const { return yWeight_.get(); }
+
+    void set_x_span(int value) { xSpan_.set(value); }
+    void set_y_span(int value) { ySpan_.set(value); }
+    void set_x_weight(float value) { xWeight_.set(value); }
+    void set_y_weight(float value) { yWeight_.set(value); }
+
+    /// Changes whenever a parameter may have changed
+    [[nodiscard]] std::uint64_t get_version() const noexcept override {
+        return std::max({xSpan_.get_version(), ySpan_.get_version(), xWeight_.get_version(), yWeight_.get_version()});
     }
 };
 
@@ -220,15 +408,23 @@ class MatrixLayout : public Node {
 
         Node::sync(proto);
 
-        xSlots_.set_proto(layout->xSlots_.get());
-        ySlots_.set_proto(layout->ySlots_.get());
-        dir_.set_proto(layout->dir_.get());
-        wrapDir_.set_proto(layout->wrapDir_.get());
-        align_.set_proto(layout->align_.get());
-        wrapAlign_.set_proto(layout->wrapAlign_.get());
+        bool changed = false;
+        changed |= xSlots_.sync(layout->xSlots_);
+        changed |= ySlots_.sync(layout->ySlots_);
+        changed |= dir_.sync(layout->dir_);
+        changed |= wrapDir_.sync(layout->wrapDir_);
+        changed |= align_.sync(layout->align_);
+        changed |= wrapAlign_.sync(layout->wrapAlign_);
+        if (changed) {
+            refresh_metric();
+        }
+    }
+
+    [[nodiscard]] std::uint64_t get_params_version() const noexcept override {
+        return std::max({Node::get_params_version(), xSlots_.get_version(), ySlots_.get_version(), dir_.get_version(), wrapDir_.get_version(), align_.get_version(), wrapAlign_.get_version()});
     }
 
-    void on_model() override;
+    void on_model(const LayoutContext &context) const override;
 };
 
 class MatrixItem : public Context {
@@ -259,10 +455,14 @@ class MatrixItem : public Context {
             throw std::runtime_error("Prototype of a different type cannot be used to synchronize parameters");
         }
 
-        xSpan_.set_proto(context->xSpan_.get());
-        ySpan_.set_proto(context->ySpan_.get());
-        xWeight_.set_proto(context->xWeight_.get());
-        yWeight_.set_proto(context->yWeight_.get());
+        xSpan_.sync(context->xSpan_);
+        ySpan_.sync(context->ySpan_);
+        xWeight_.sync(context->xWeight_);
+        yWeight_.sync(context->yWeight_);
+    }
+
+    [[nodiscard]] std::uint64_t get_version() const noexcept override {
+        return std::max({xSpan_.get_version(), ySpan_.get_version(), xWeight_.get_version(), yWeight_.get_version()});
     }
 };
 
@@ -296,13 +496,21 @@ class SplitLayout : public Node {
 
         Node::sync(proto);
 
-        splitWeights_.set_proto(layout->splitWeights_.get());
-        splitDir_.set_proto(layout->splitDir_.get());
-        wrapDir_.set_proto(layout->wrapDir_.get());
-        minDepth_.set_proto(layout->minDepth_.get());
+        bool changed = false;
+        changed |= splitWeights_.sync(layout->splitWeights_);
+        changed |= splitDir_.sync(layout->splitDir_);
+        changed |= wrapDir_.sync(layout->wrapDir_);
+        changed |= minDepth_.sync(layout->minDepth_);
+        if (changed) {
+            refresh_metric();
+        }
     }
 
-    void on_model() override;
+    [[nodiscard]] std::uint64_t get_params_version() const noexcept override {
+        return std::max({Node::get_params_version(), splitWeights_.get_version(), splitDir_.get_version(), wrapDir_.get_version(), minDepth_.get_version()});
+    }
+
+    void on_model(const LayoutContext &context) const override;
 };
 
 class SplitItem : public Context {
@@ -328,4 +536,9 @@ class SplitItem : public Context {
             throw std::runtime_error("Prototype of a different type cannot be used to synchronize parameters");
         }
     }
+
+    /// Note: no parameters, so never changes
+    [[nodiscard]] std::uint64_t get_version() const noexcept override {
+        return 1;
+    }
 };
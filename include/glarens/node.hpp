@@ -9,11 +9,18 @@
 #pragma once
 
 #include "glarens/math.hpp"
+#include "glarens/profiler.hpp"
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <source_location>
+#include <span>
 #include <type_traits>
 #include <typeindex>
+#include <utility>
 #include <unordered_map>
 #include <vector>
 
@@ -22,6 +29,16 @@ enum ReferenceMode {
     REF_MODE_ABSOLUTE  /// Uses screen metric for modeling reference (0, 0, GetScreenWidth(), GetScreenHeight()).
 };
 
+/// Snapshot of the environment, captured once per layout pass
+struct LayoutContext {
+    Vec2          viewport;        /// Viewport size
+    float         dpiScale = 1.0f; /// Display scale of the viewport
+    std::uint64_t frameId  = 0;    /// Identifier of the layout pass
+
+    /// Captures the current window state
+    [[nodiscard]] static LayoutContext capture();
+};
+
 struct BoxDim {
     Vec2 pos;      /// Offset from reference position.
     Vec2 anchor;   /// Additional offset from reference size.
@@ -46,9 +63,17 @@ struct BoxMetric {
     Rect  bounds;          /// Bounding box
     float rotation = 0.0f; /// Rotation from center
 
-    static BoxMetric screen_metric();
+    [[nodiscard]] static BoxMetric screen_metric(const LayoutContext &context) noexcept {
+        return BoxMetric{
+            .bounds   = Rect::from_xywh(Vec2(0.0f, 0.0f), context.viewport),
+            .rotation = 0.0f
+        };
+    }
 };
 
+[[nodiscard]] inline bool operator==(BoxMetric a, BoxMetric b) noexcept { return a.bounds == b.bounds && a.rotation == b.rotation; }
+[[nodiscard]] inline bool operator!=(BoxMetric a, BoxMetric b) noexcept { return a.bounds != b.bounds || a.rotation != b.rotation; }
+
 struct Transformation {
     ReferenceMode originRefMode = REF_MODE_RELATIVE; /// Reference mode for positioning the origin point of transformation
 
@@ -65,16 +90,172 @@ using TStack = std::vector<Transformation>;
 
 // Provide screen metric in case of no parent
 
-[[nodiscard]] BoxMetric model_dim(BoxDim dim, BoxMetric parentMetric) noexcept;
-[[nodiscard]] BoxMetric model_box(BoxModel model, BoxMetric parentMetric) noexcept;
-[[nodiscard]] BoxMetric transform_box(BoxMetric metric, Transformation t, BoxMetric parentMetric) noexcept;
-[[nodiscard]] BoxMetric transform_box(BoxMetric metric, const TStack &tStack, BoxMetric parentMetric) noexcept;
+[[nodiscard]] inline BoxMetric model_dim(const BoxDim &dim, BoxMetric parentMetric, const LayoutContext &context) noexcept {
+    Vec2 refPos  = dim.positioningRefMode == REF_MODE_ABSOLUTE ? context.viewport / 2.0f : parentMetric.bounds.center;
+    Vec2 refSize = dim.sizingRefMode == REF_MODE_ABSOLUTE ? context.viewport : parentMetric.bounds.extent;
+
+    Vec2 finalSize = dim.size + dim.scale * refSize;
+    Vec2 finalPos  = dim.pos + refPos + dim.anchor * refSize + dim.floating * finalSize;
+
+    return BoxMetric{
+        .bounds   = Rect(finalPos, finalSize),
+        .rotation = 0.0f
+    };
+}
+
+[[nodiscard]] inline BoxMetric model_box(const BoxModel &model, BoxMetric parentMetric, const LayoutContext &context) noexcept {
+    BoxMetric metric = model_dim(model, parentMetric, context);
+
+    if (model.min.has_value()) {
+        BoxMetric minMetric = model_dim(*model.min, parentMetric, context);
+        metric.bounds       = unionsection(metric.bounds, minMetric.bounds);
+    }
+
+    if (model.max.has_value()) {
+        BoxMetric maxMetric = model_dim(*model.max, parentMetric, context);
+        metric.bounds       = intersection(metric.bounds, maxMetric.bounds);
+    }
+
+    return metric;
+}
+
+[[nodiscard]] inline BoxMetric transform_box(BoxMetric metric, const Transformation &t, BoxMetric parentMetric, const LayoutContext &context) noexcept {
+    Vec2 refPos  = t.originRefMode == REF_MODE_ABSOLUTE ? context.viewport / 2.0f : parentMetric.bounds.center;
+    Vec2 refSize = t.originRefMode == REF_MODE_ABSOLUTE ? context.viewport : parentMetric.bounds.extent;
+
+    Vec2 origin = refPos + t.originPos + t.originAnchor * refSize + t.originFloating * metric.bounds.extent;
+
+    Vec2 v = metric.bounds.center - origin;
+    v *= t.scale;
+
+    metric.bounds.extent *= abs(t.scale);
+
+    v = rotate(v, t.rotate);
+    metric.rotation += t.rotate;
+
+    metric.bounds.center = origin + v + t.offset;
+
+    return metric;
+}
+
+[[nodiscard]] inline BoxMetric transform_box(BoxMetric metric, const TStack &tStack, BoxMetric parentMetric, const LayoutContext &context) noexcept {
+    for (const Transformation &t : tStack) {
+        metric = transform_box(metric, t, parentMetric, context);
+    }
+
+    return metric;
+}
+
+inline const Mat3 IDENTITY_TRANSFORM = Mat3(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+
+/// Transformation stack composed into a single affine map
+struct ComposedTransform {
+    Mat3  matrix   = IDENTITY_TRANSFORM; /// Maps modeled center to transformed center
+    Vec2  scale    = Vec2(1.0f, 1.0f);   /// Accumulated extent scaling
+    float rotation = 0.0f;               /// Accumulated rotation
+};
+
+/// Equivalent to applying transform_box for each transformation, with the trigonometry done once
+[[nodiscard]] inline ComposedTransform compose_transform(const TStack &tStack, Vec2 extent, BoxMetric parentMetric, const LayoutContext &context) noexcept {
+    ComposedTransform composed;
+
+    for (const Transformation &t : tStack) {
+        Vec2 refPos  = t.originRefMode == REF_MODE_ABSOLUTE ? context.viewport / 2.0f : parentMetric.bounds.center;
+        Vec2 refSize = t.originRefMode == REF_MODE_ABSOLUTE ? context.viewport : parentMetric.bounds.extent;
+
+        Vec2 origin = refPos + t.originPos + t.originAnchor * refSize + t.originFloating * extent * composed.scale;
+
+        float c = cos(t.rotate);
+        float s = sin(t.rotate);
+
+        // p' = R * S * (p - origin) + origin + offset
+        Mat3 step(
+            c * t.scale.x, -s * t.scale.y, 0.0f,
+            s * t.scale.x, c * t.scale.y, 0.0f,
+            0.0f, 0.0f, 1.0f
+        );
+        step.m[2] = origin.x + t.offset.x - (step.m[0] * origin.x + step.m[1] * origin.y);
+        step.m[5] = origin.y + t.offset.y - (step.m[3] * origin.x + step.m[4] * origin.y);
+
+        composed.matrix = mm(step, composed.matrix);
+        composed.scale *= abs(t.scale);
+        composed.rotation += t.rotate;
+    }
+
+    return composed;
+}
+
+[[nodiscard]] inline BoxMetric apply_transform(BoxMetric metric, const ComposedTransform &composed) noexcept {
+    metric.bounds.center = Vec2(mr(composed.matrix, Vec3(metric.bounds.center, 1.0f)));
+    metric.bounds.extent *= composed.scale;
+    metric.rotation += composed.rotation;
+    return metric;
+}
+
+/// Reference metric a lazily transformed node provides to its children
+/// Only the transformed extent is kept, offset and rotation are applied visually
+[[nodiscard]] inline BoxMetric lazy_reference(BoxMetric mMetric, BoxMetric tMetric) noexcept {
+    return BoxMetric{
+        .bounds   = Rect(mMetric.bounds.center, tMetric.bounds.extent),
+        .rotation = 0.0f
+    };
+}
+
+/// Maps points from the unrotated frame centered on the metric to world
+[[nodiscard]] inline Mat3 local_to_world(BoxMetric metric) noexcept {
+    float c = cos(metric.rotation);
+    float s = sin(metric.rotation);
+    return Mat3(
+        c, -s, metric.bounds.center.x,
+        s, c, metric.bounds.center.y,
+        0.0f, 0.0f, 1.0f
+    );
+}
+
+/// Maps points from world to the unrotated frame centered on the metric
+[[nodiscard]] inline Mat3 world_to_local(BoxMetric metric) noexcept {
+    float c = cos(metric.rotation);
+    float s = sin(metric.rotation);
+    Vec2  p = metric.bounds.center;
+    return Mat3(
+        c, s, -(c * p.x + s * p.y),
+        -s, c, s * p.x - c * p.y,
+        0.0f, 0.0f, 1.0f
+    );
+}
+
+/// In-place access to a value, running a callback once the edit goes out of scope
+template <typename T, typename Fn>
+class ScopedEdit {
+    T *value_;
+    Fn done_;
+
+  public:
+    ScopedEdit(T &value, Fn done) : value_(&value), done_(std::move(done)) {}
+
+    ScopedEdit(const ScopedEdit &)            = delete;
+    ScopedEdit &operator=(const ScopedEdit &) = delete;
+
+    ~ScopedEdit() { done_(); }
+
+    [[nodiscard]] T &operator*() const noexcept { return *value_; }
+    [[nodiscard]] T *operator->() const noexcept { return value_; }
+};
+
+/// Allocates the next parameter version, unique across all parameters
+[[nodiscard]] inline std::uint64_t next_param_version() noexcept {
+    static std::atomic<std::uint64_t> counter = 1;
+    return counter++;
+}
 
 template <typename T>
 class Param {
     T                proto = T(); /// Prototype value
     std::optional<T> local;       /// Local override
 
+    std::uint64_t version = 0; /// Changes whenever the effective value may have changed, 0 if never modified
+    std::uint64_t synced  = 0; /// Version of the prototype parameter last synchronized from
+
   public:
     Param()                              = default;
     Param(const Param &param)            = default;
@@ -100,19 +281,70 @@ class Param {
         return proto;
     }
 
-    void set(const T &value) { local = value; }
-    void set(T &&value) { local = std::move(value); }
+    void set(const T &value) {
+        local   = value;
+        version = next_param_version();
+    }
+
+    void set(T &&value) {
+        local   = std::move(value);
+        version = next_param_version();
+    }
+
+    /// Local override for in-place modification, initialized from the prototype if missing
+    /// Note: call touch() once the modification is done
+    [[nodiscard]] T &edit() {
+        if (!local.has_value()) local = proto;
+        version = next_param_version();
+        return *local;
+    }
+
+    /// Marks the value as modified after in-place edits
+    void touch() noexcept { version = next_param_version(); }
+
+    void set_proto(const T &value) {
+        proto   = value;
+        version = next_param_version();
+    }
+
+    void set_proto(T &&value) {
+        proto   = std::move(value);
+        version = next_param_version();
+    }
 
-    void set_proto(const T &value) { proto = value; }
-    void set_proto(T &&value) { proto = std::move(value); }
+    /// Copies the effective value of the prototype parameter only if it has changed since the last call
+    /// Returns whether the effective value of this parameter has changed
+    bool sync(const Param &source) {
+        if (source.version == synced) {
+            return false;
+        }
 
-    void clear() noexcept { local.reset(); }
+        proto   = source.get();
+        synced  = source.version;
+        version = next_param_version();
+        return !local.has_value();
+    }
+
+    void clear() noexcept {
+        local.reset();
+        version = next_param_version();
+    }
+
+    [[nodiscard]] std::uint64_t get_version() const noexcept {
+        return version;
+    }
 
     [[nodiscard]] bool has_override() const noexcept {
         return local.has_value();
     }
 };
 
+/// Allocates the next dense context type identifier
+[[nodiscard]] inline std::size_t next_context_id() noexcept {
+    static std::atomic<std::size_t> counter = 0;
+    return counter++;
+}
+
 class Context : public std::enable_shared_from_this<Context> {
   protected:
     Context();
@@ -122,17 +354,148 @@ class Context : public std::enable_shared_from_this<Context> {
 
     virtual std::shared_ptr<Context> clone()                                     = 0;
     virtual void                     sync(const std::shared_ptr<Context> &proto) = 0;
+
+    /// Changes whenever a parameter may have changed, lets Node::sync_clones() skip unchanged contexts
+    /// Note: 0 if unknown, e.g. for plain fields modified directly; such contexts are synchronized on every call
+    [[nodiscard]] virtual std::uint64_t get_version() const noexcept {
+        return 0;
+    }
+};
+
+/// Dense identifier of a context type, assigned on first use
+template <typename T>
+    requires std::is_base_of_v<Context, T>
+[[nodiscard]] std::size_t context_id() noexcept {
+    static const std::size_t id = next_context_id();
+    return id;
+}
+
+class Node;
+struct RenderRecording;
+struct LayerTexture;
+struct InvalidationCounters;
+
+enum InvalidationReason {
+    INVALIDATION_NONE,      /// Never invalidated while tracking
+    INVALIDATION_MODEL,     /// Model changed, e.g. set_model()
+    INVALIDATION_TRANSFORM, /// Transformation stack or lazy transformation changed, e.g. set_t_stack()
+    INVALIDATION_REFRESH,   /// Explicit refresh_metric() or refresh_layout(), e.g. layout parameter changes
+    INVALIDATION_SYNC,      /// Synchronized from the prototype
+    INVALIDATION_INSERT,    /// Inserted into a parent
+    INVALIDATION_REMOVE     /// Removed from its parent
+};
+
+/// Invalidation accounting of a node while tracking is enabled, see glarens_set_invalidation_tracking()
+struct InvalidationStats {
+    std::uint64_t        invalidations = 0;                 /// Times the node was invalidated
+    std::uint64_t        recomputes    = 0;                 /// Times layout recomputed its metrics
+    std::uint64_t        touched       = 0;                 /// Descendants recomputed because of its own invalidations
+    InvalidationReason   reason        = INVALIDATION_NONE; /// Reason of the last invalidation
+    std::source_location where;                             /// Call site of the last invalidation
 };
 
+/// Clones the prototype count times and appends the instances to the parent (if any) in bulk
+/// Note: the instances are laid out together by the next layout flush
+std::vector<std::shared_ptr<Node>> instantiate(const std::shared_ptr<Node> &proto, std::size_t count, const std::shared_ptr<Node> &parent = nullptr, const std::source_location &where = std::source_location::current());
+
 class Node : public std::enable_shared_from_this<Node> {
+    friend class NodeArena;
+    friend class SpatialIndex;
+
+    friend std::vector<std::shared_ptr<Node>> instantiate(const std::shared_ptr<Node> &proto, std::size_t count, const std::shared_ptr<Node> &parent, const std::source_location &where);
+
     Param<BoxModel> model_;
     Param<TStack>   tStack_;
 
     mutable BoxMetric mMetric_;
     mutable BoxMetric tMetric_;
 
-    void update_m_metric_() const;
-    void update_t_metric_() const;
+    mutable ComposedTransform composed_;             /// Cached composition of the transformation stack
+    mutable bool              composedStale_ = true; /// Transformation stack changed since composition
+    mutable BoxMetric         composedRef_;          /// Reference metric the composition was made against
+    mutable Vec2              composedSize_;         /// Modeled extent the composition was made against
+    mutable Vec2              composedView_;         /// Viewport the composition was made against
+
+    mutable Mat3 localToWorld_ = IDENTITY_TRANSFORM;
+    mutable Mat3 worldToLocal_ = IDENTITY_TRANSFORM;
+
+    bool              lazyTransform_ = false;              /// Children follow offset and rotation visually instead of being re-modeled
+    mutable BoxMetric childRef_;                           /// Reference metric provided to children
+    mutable Mat3      lazy_          = IDENTITY_TRANSFORM; /// Visual transformation applied to children
+    mutable Mat3      world_         = IDENTITY_TRANSFORM; /// Accumulated lazy transformation of ancestors
+    mutable Mat3      worldInv_      = IDENTITY_TRANSFORM;
+    mutable float     worldAngle_    = 0.0f;
+
+    void place_child_(const Node &child) const;
+
+    /// Marks the world bounds of every node in this subtree as damaged
+    void damage_subtree_() const;
+
+    /// Returns whether the reference metric for children has changed
+    bool store_t_metric_(BoxMetric metric) const;
+
+    mutable bool modelDirty_     = true;  /// Model metric needs recomputation
+    mutable bool transformDirty_ = false; /// Transformed metric needs recomputation
+    mutable bool childrenDirty_  = false; /// Some descendant needs recomputation
+    mutable bool renderDirty_    = true;  /// Retained geometry of this subtree is stale
+    mutable bool contentDirty_   = true;  /// Layer texture contents are stale
+
+    mutable std::vector<const Node *> dirtyChildren_;          /// Children needing recomputation, the only ones visited unless the reference metric changed
+    mutable std::size_t               changedFrom_ = SIZE_MAX; /// Index of the first child inserted or removed since the last on_model(), 0 after refresh_layout()
+
+    mutable std::shared_ptr<RenderRecording> recording_;    /// Retained geometry, if enabled
+    mutable Rect                             recordRegion_; /// Visible region the geometry was recorded against
+    mutable std::shared_ptr<LayerTexture>    layerTexture_; /// Cached contents, if a layer
+
+    mutable std::shared_ptr<InvalidationCounters> counters_; /// Invalidation accounting, once tracked
+
+    InvalidationCounters &counters_for_() const;
+
+    void count_invalidation_(InvalidationReason reason, const std::source_location &where) const;
+    void count_recompute_(const Node *origin) const;
+
+    /// Renders this node and its children without culling or retaining itself
+    void draw_(bool visible) const;
+
+    /// Renders the subtree into the layer texture if stale, then composites it
+    /// Returns false if the subtree has to be rendered directly instead
+    bool render_layer_() const;
+
+    std::size_t subtreeSize_ = 1; /// Number of nodes in this subtree, including itself
+
+    void adjust_subtree_size_(std::ptrdiff_t delta);
+
+    std::vector<std::size_t> holders_; /// Number of nodes holding each context in this subtree, including itself, indexed by context_id
+
+    void adjust_holders_(std::size_t id, std::ptrdiff_t delta);
+    void adjust_holders_(const std::vector<std::size_t> &counts, std::ptrdiff_t sign);
+
+    /// Appends the children with a single update of the ancestors, see insert_child()
+    void attach_children_(std::span<const std::shared_ptr<Node>> children, const std::source_location &where);
+
+    [[nodiscard]] std::size_t holders_in_descendant_(std::size_t id) const noexcept {
+        if (id >= holders_.size()) {
+            return 0;
+        }
+        return holders_[id] - (id < contexts_.size() && contexts_[id] ? 1 : 0);
+    }
+
+    void invalidate_model_(InvalidationReason reason, const std::source_location &where) const;
+    void invalidate_transform_(InvalidationReason reason, const std::source_location &where) const;
+    void propagate_dirty_() const;
+
+    /// Records a child that started to need recomputation
+    void mark_child_dirty_(const Node *child) const;
+
+    /// Makes the next flush descend into this node and run on_model()
+    void invalidate_children_() const;
+
+    [[nodiscard]] bool needs_layout_() const noexcept {
+        return modelDirty_ || transformDirty_ || childrenDirty_;
+    }
+
+    /// Origin is the nearest ancestor whose own invalidation forced this recompute, for accounting
+    void flush_layout_(const LayoutContext &context, BoxMetric parentMetric, bool force, const Node *origin) const;
 
     std::weak_ptr<Node>                parent_;
     std::vector<std::shared_ptr<Node>> children_;
@@ -140,7 +503,32 @@ class Node : public std::enable_shared_from_this<Node> {
     std::weak_ptr<Node>              proto_;
     std::vector<std::weak_ptr<Node>> clones_;
 
-    std::unordered_map<std::type_index, std::shared_ptr<Context>> contexts_;
+    /// Drops expired clones and makes room for count more in this subtree
+    void reserve_clones_(std::size_t count);
+
+    std::vector<std::shared_ptr<Context>> contexts_; /// Indexed by context_id
+
+    std::uint64_t                contextsVersion_ = 0; /// Changes whenever a context is set or reset
+    std::optional<std::uint64_t> clonesSynced_;        /// Version every clone was last synchronized to, see get_sync_version_()
+
+    /// Latest version of the parameters and contexts, none if some context is unversioned
+    [[nodiscard]] std::optional<std::uint64_t> get_sync_version_() const noexcept;
+
+    struct Inherited {
+        Context *context  = nullptr;
+        bool     resolved = false;
+    };
+
+    mutable std::vector<Inherited> inherited_; /// Cached ancestor contexts, indexed by context_id
+    // Note: a resolved entry implies a resolved parent entry unless the parent holds the context, so invalidation stops at unresolved nodes
+
+    inline static std::atomic<std::size_t> parallelLayouts_ = 0; /// Parallel layout passes in flight, during which caches are only read
+
+    /// Drops cached ancestor contexts of the id in this subtree (excluding itself), down to nodes holding their own
+    void forget_inherited_(std::size_t id) const;
+
+    /// Drops every cached ancestor context in this subtree (including itself), e.g. after reparenting
+    void forget_inherited_() const;
 
   protected:
     Node();
@@ -152,30 +540,149 @@ class Node : public std::enable_shared_from_this<Node> {
     bool enableChildrenUpdate = true; /// Enable updates for children
     bool enableRender         = true; /// Enable renders
     bool enableChildrenRender = true; /// Enable renders for children
+    bool enableCulling        = true;  /// Skip rendering while the bounds are outside the viewport and clip rect
+    bool childrenInside       = false; /// Children stay within the bounds, so the whole subtree is culled with it
+    bool retainRender         = false; /// Records the batched geometry of this subtree and replays it until invalidated
+    bool layer                = false; /// Renders the subtree once into a texture of the bounds and composites it until invalidated
+
+    // Note: a layer clips its children to its bounds, and with a lazy transformation, moving it composites the
+    // same texture without re-rendering; its descendants then keep the world placement of the last redraw
 
-    BoxModel get_model() const {
+    /// Marks the retained geometry of this node and its ancestors as stale, and its bounds as damaged
+    /// Note: needed after changes that layout does not see, e.g. colors or enable flags
+    void invalidate_render() const;
+
+    /// Updates the lazy world transformation of all descendants without rendering
+    void place_descendants() const;
+
+    [[nodiscard]] const BoxModel &get_model() const noexcept {
         return model_.get();
     }
 
-    void set_model(const BoxModel &value) {
+    /// Changes whenever the model may have changed, e.g. to tell edits of others from own writes
+    [[nodiscard]] std::uint64_t get_model_version() const noexcept {
+        return model_.get_version();
+    }
+
+    void set_model(const BoxModel &value, const std::source_location &where = std::source_location::current()) {
         model_.set(value);
-        update_m_metric_();
+        invalidate_model_(INVALIDATION_MODEL, where);
     }
 
-    TStack get_t_stack() const {
+    [[nodiscard]] const TStack &get_t_stack() const noexcept {
         return tStack_.get();
     }
 
-    void set_t_stack(const TStack &value) {
+    void set_t_stack(const TStack &value, const std::source_location &where = std::source_location::current()) {
         tStack_.set(value);
-        update_t_metric_();
+        invalidate_transform_(INVALIDATION_TRANSFORM, where);
+    }
+
+    /// Modifies the model in place, invalidating once when the returned edit is destroyed
+    [[nodiscard]] auto edit_model(const std::source_location &where = std::source_location::current()) {
+        return ScopedEdit(model_.edit(), [this, where] {
+            model_.touch();
+            invalidate_model_(INVALIDATION_MODEL, where);
+        });
+    }
+
+    /// Modifies the transformation stack in place, invalidating once when the returned edit is destroyed
+    [[nodiscard]] auto edit_t_stack(const std::source_location &where = std::source_location::current()) {
+        return ScopedEdit(tStack_.edit(), [this, where] {
+            tStack_.touch();
+            invalidate_transform_(INVALIDATION_TRANSFORM, where);
+        });
+    }
+
+    /// Modeled metric (before transformation), valid after layout is flushed
+    [[nodiscard]] const BoxMetric &get_m_metric() const noexcept {
+        return mMetric_;
+    }
+
+    /// Transformed metric, valid after layout is flushed
+    [[nodiscard]] const BoxMetric &get_t_metric() const noexcept {
+        return tMetric_;
+    }
+
+    /// Pure offset and rotation changes of this node are applied to its children at render and hit test time
+    /// Children are only re-modeled when the transformed extent changes
+    void set_lazy_transform(bool value, const std::source_location &where = std::source_location::current()) {
+        lazyTransform_ = value;
+        invalidate_transform_(INVALIDATION_TRANSFORM, where);
+    }
+
+    [[nodiscard]] bool is_lazy_transform() const noexcept {
+        return lazyTransform_;
     }
 
-    /// Note: propagates updates down to children
-    void refresh_metric() const {
-        update_m_metric_();
+    /// Accumulated lazy transformation of ancestors, valid after render() or debug()
+    [[nodiscard]] const Mat3 &get_world() const noexcept {
+        return world_;
     }
 
+    /// Transformed metric with the lazy transformation of ancestors applied, valid after render() or debug()
+    [[nodiscard]] BoxMetric get_world_metric() const noexcept {
+        BoxMetric metric     = tMetric_;
+        metric.bounds.center = Vec2(mr(world_, Vec3(tMetric_.bounds.center, 1.0f)));
+        metric.rotation += worldAngle_;
+        return metric;
+    }
+
+    /// Axis-aligned bounds of the world metric, valid after render() or debug()
+    [[nodiscard]] Rect get_world_bounds() const noexcept;
+
+    /// Composed transformation stack, valid after layout is flushed
+    [[nodiscard]] const ComposedTransform &get_composed_transform() const noexcept {
+        return composed_;
+    }
+
+    /// Maps from the unrotated frame of the transformed metric to world, valid after layout is flushed
+    [[nodiscard]] const Mat3 &get_local_to_world() const noexcept {
+        return localToWorld_;
+    }
+
+    /// Maps from world to the unrotated frame of the transformed metric, valid after layout is flushed
+    [[nodiscard]] const Mat3 &get_world_to_local() const noexcept {
+        return worldToLocal_;
+    }
+
+    /// Number of nodes in this subtree, including itself
+    [[nodiscard]] std::size_t get_subtree_size() const noexcept {
+        return subtreeSize_;
+    }
+
+    /// Snapshot of the invalidation accounting, zero unless tracked
+    [[nodiscard]] InvalidationStats get_invalidation_stats() const;
+
+    /// Note: deferred until the next flush_layout, which propagates updates down to children
+    void refresh_metric(const std::source_location &where = std::source_location::current()) const {
+        invalidate_model_(INVALIDATION_REFRESH, where);
+    }
+
+    /// Runs on_model() again at the next flush_layout, e.g. after changing item contexts of the children
+    void refresh_layout(const std::source_location &where = std::source_location::current()) const;
+
+    /// Children modeled or invalidated since the previous flush, in no particular order, valid within on_model()
+    /// Note: children inserted since then are included
+    [[nodiscard]] const std::vector<const Node *> &get_dirty_children() const noexcept {
+        return dirtyChildren_;
+    }
+
+    /// Index of the first child inserted or removed since the previous on_model(), SIZE_MAX if none
+    /// Note: 0 after refresh_layout(), as if every child had changed
+    [[nodiscard]] std::size_t get_first_changed_child() const noexcept {
+        return changedFrom_;
+    }
+
+    /// Reference metric provided to children, valid after layout is flushed and within on_model()
+    [[nodiscard]] const BoxMetric &get_child_reference() const noexcept {
+        return childRef_;
+    }
+
+    /// Recomputes metrics of invalidated nodes in this subtree and their affected descendants
+    /// Note: called automatically by render() and debug()
+    void flush_layout() const;
+
     /// Derived must provide their own independent factory
     [[nodiscard]] static std::shared_ptr<Node> create() {
         return std::shared_ptr<Node>(new Node());
@@ -187,9 +694,20 @@ class Node : public std::enable_shared_from_this<Node> {
     }
 
     /// Derived must provide their own sync function
+    /// Note: only parameters changed since the last sync are copied, and the node is invalidated accordingly
     virtual void sync(const std::shared_ptr<Node> &proto) {
-        model_.set_proto(proto->model_.get());
-        tStack_.set_proto(proto->tStack_.get());
+        if (model_.sync(proto->model_)) {
+            invalidate_model_(INVALIDATION_SYNC, std::source_location::current());
+        }
+        if (tStack_.sync(proto->tStack_)) {
+            invalidate_transform_(INVALIDATION_SYNC, std::source_location::current());
+        }
+    }
+
+    /// Changes whenever a parameter may have changed, lets sync_clones() skip unchanged prototypes
+    /// Note: derived with their own parameters must include them, like in their sync function
+    [[nodiscard]] virtual std::uint64_t get_params_version() const noexcept {
+        return std::max(model_.get_version(), tStack_.get_version());
     }
 
     [[nodiscard]] std::shared_ptr<Node> clone() {
@@ -200,13 +718,21 @@ class Node : public std::enable_shared_from_this<Node> {
         clones_.push_back(clone);
         clone->proto_ = shared_from_this();
 
-        for (const auto &[type, context] : contexts_) {
-            clone->contexts_[type] = context->clone();
+        clone->contexts_.resize(contexts_.size());
+        clone->holders_.resize(contexts_.size());
+        for (std::size_t id = 0; id < contexts_.size(); id++) {
+            if (contexts_[id]) {
+                clone->contexts_[id] = contexts_[id]->clone();
+                clone->holders_[id]  = 1;
+            }
         }
 
+        std::vector<std::shared_ptr<Node>> children;
+        children.reserve(children_.size());
         for (const auto &child : children_) {
-            clone->insert_child(child->clone());
+            children.push_back(child->clone());
         }
+        clone->attach_children_(children, std::source_location::current());
 
         return clone;
     }
@@ -219,38 +745,53 @@ class Node : public std::enable_shared_from_this<Node> {
         clones_.push_back(clone);
         clone->proto_ = shared_from_this();
 
-        for (const auto &[type, context] : contexts_) {
-            clone->contexts_[type] = context->clone();
+        clone->contexts_.resize(contexts_.size());
+        clone->holders_.resize(contexts_.size());
+        for (std::size_t id = 0; id < contexts_.size(); id++) {
+            if (contexts_[id]) {
+                clone->contexts_[id] = contexts_[id]->clone();
+                clone->holders_[id]  = 1;
+            }
         }
 
         return clone;
     }
 
+    /// Synchronizes the clones of every node in this subtree
+    /// Note: clones of a node are only synchronized if its parameters or contexts changed since the last call, expired ones are always dropped
     void sync_clones() {
         clones_.erase(std::remove_if(clones_.begin(), clones_.end(), [](const std::weak_ptr<Node> &clone) { return clone.expired(); }), clones_.end());
-        for (const auto &clone_ : clones_) {
-            if (auto clone = clone_.lock()) {
-                clone->sync(shared_from_this());
 
-                for (const auto &[type, context] : contexts_) {
-                    if (auto it = clone->contexts_.find(type); it != clone->contexts_.end()) {
-                        it->second->sync(context);
+        std::optional<std::uint64_t> version = get_sync_version_();
+        if (!version || version != clonesSynced_) {
+            for (const auto &clone_ : clones_) {
+                if (auto clone = clone_.lock()) {
+                    clone->sync(shared_from_this());
+
+                    for (std::size_t id = 0; id < contexts_.size() && id < clone->contexts_.size(); id++) {
+                        if (contexts_[id] && clone->contexts_[id]) {
+                            clone->contexts_[id]->sync(contexts_[id]);
+                        }
                     }
                 }
             }
+            clonesSynced_ = version;
         }
 
-        for (auto child : children_) {
+        for (const auto &child : children_) {
             child->sync_clones();
         }
     }
 
+    /// Number of clones tracked for synchronization, expired ones included until the next sync_clones()
+    [[nodiscard]] std::size_t get_clone_count() const noexcept {
+        return clones_.size();
+    }
+
     // Note: node tree graph management does not enforce anything
 
-    void insert_child(std::shared_ptr<Node> child) {
-        child->parent_ = shared_from_this();
-        child->refresh_metric();
-        children_.push_back(std::move(child));
+    void insert_child(std::shared_ptr<Node> child, const std::source_location &where = std::source_location::current()) {
+        attach_children_({&child, 1}, where);
     }
 
     template <typename T = Node, typename... Args>
@@ -261,17 +802,33 @@ class Node : public std::enable_shared_from_this<Node> {
         return node;
     }
 
-    bool remove_child(const std::shared_ptr<Node> &child) {
+    bool remove_child(const std::shared_ptr<Node> &child, const std::source_location &where = std::source_location::current()) {
         auto it = std::find_if(children_.begin(), children_.end(), [&child](const std::shared_ptr<Node> &element) { return child.get() == element.get(); });
         if (it == children_.end()) {
             return false;
         }
+        auto index = static_cast<std::size_t>(it - children_.begin());
+        (*it)->damage_subtree_();
         (*it)->parent_.reset();
-        (*it)->refresh_metric();
+        (*it)->invalidate_model_(INVALIDATION_REMOVE, where);
+        (*it)->forget_inherited_();
+        adjust_subtree_size_(-static_cast<std::ptrdiff_t>((*it)->subtreeSize_));
+        adjust_holders_((*it)->holders_, -1);
         children_.erase(it);
+        std::erase(dirtyChildren_, child.get());
+
+        // Layouts arrange the remaining children again
+        changedFrom_ = std::min(changedFrom_, index);
+        invalidate_children_();
+
+        invalidate_render();
         return true;
     }
 
+    [[nodiscard]] const std::vector<std::shared_ptr<Node>> &get_children() const noexcept {
+        return children_;
+    }
+
     [[nodiscard]] bool has_child(const std::shared_ptr<Node> &child) const noexcept {
         return std::find_if(children_.begin(), children_.end(), [&child](const std::shared_ptr<Node> &element) { return child.get() == element.get(); }) != children_.end();
     }
@@ -287,106 +844,149 @@ class Node : public std::enable_shared_from_this<Node> {
     template <typename T>
         requires std::is_base_of_v<Context, T>
     void set_context(std::shared_ptr<T> context) {
-        std::type_index type = typeid(T);
-        contexts_[type]      = context;
+        std::size_t id = context_id<T>();
+        if (id >= contexts_.size()) {
+            contexts_.resize(id + 1);
+        }
+        if (bool(contexts_[id]) != bool(context)) {
+            adjust_holders_(id, context ? 1 : -1);
+        }
+        contexts_[id]    = std::move(context);
+        contextsVersion_ = next_param_version();
+        forget_inherited_(id);
     }
 
     template <typename T>
         requires std::is_base_of_v<Context, T>
     void reset_context() {
-        std::type_index type = typeid(T);
-        contexts_.erase(type);
+        std::size_t id = context_id<T>();
+        if (id < contexts_.size() && contexts_[id]) {
+            contexts_[id].reset();
+            contextsVersion_ = next_param_version();
+            adjust_holders_(id, -1);
+            forget_inherited_(id);
+        }
     }
 
     template <typename T>
         requires std::is_base_of_v<Context, T>
     [[nodiscard]] bool has_context() const noexcept {
-        std::type_index type = typeid(T);
-        return contexts_.contains(type);
+        std::size_t id = context_id<T>();
+        return id < contexts_.size() && contexts_[id];
     }
 
+    /// Note: the node keeps ownership of the context
     template <typename T>
         requires std::is_base_of_v<Context, T>
-    [[nodiscard]] std::shared_ptr<T> get_context() const {
-        if (!has_context<T>()) {
+    [[nodiscard]] T *get_context() const noexcept {
+        std::size_t id = context_id<T>();
+        if (id >= contexts_.size()) {
             return nullptr;
         }
 
-        std::type_index type = typeid(T);
-        return std::static_pointer_cast<T>(contexts_.at(type));
+        return static_cast<T *>(contexts_[id].get());
     }
 
     /// Checks for context in parent recursively (excluding itself)
     template <typename T>
         requires std::is_base_of_v<Context, T>
-    [[nodiscard]] bool has_context_in_ancestor() const noexcept {
-        if (auto parent = parent_.lock()) {
-            if (parent->has_context<T>()) {
-                return true;
-            }
-
-            return parent->has_context_in_ancestor<T>();
-        }
-
-        return false;
+    [[nodiscard]] bool has_context_in_ancestor() const {
+        return get_context_in_ancestor<T>() != nullptr;
     }
 
     /// Checks for context in children recursively (excluding itself)
     template <typename T>
         requires std::is_base_of_v<Context, T>
     [[nodiscard]] bool has_context_in_descendant() const noexcept {
-        for (auto child : children_) {
-            if (child->has_context<T>()) {
-                return true;
-            }
-
-            if (child->has_context_in_descendant<T>()) {
-                return true;
-            }
-        }
+        return holders_in_descendant_(context_id<T>()) != 0;
+    }
 
-        return false;
+    /// Counts descendants holding the context (excluding itself)
+    template <typename T>
+        requires std::is_base_of_v<Context, T>
+    [[nodiscard]] std::size_t count_context_in_descendant() const noexcept {
+        return holders_in_descendant_(context_id<T>());
     }
 
     /// Obtains context in parent recursively (excluding itself)
+    /// Note: the result is cached until a context of this type changes above it, or a node above it is reparented
+    /// Note: during parallel layout passes the cache is only read, so sibling subtrees may look up concurrently
     template <typename T>
         requires std::is_base_of_v<Context, T>
-    [[nodiscard]] std::shared_ptr<T> get_context_in_ancestor() const {
+    [[nodiscard]] T *get_context_in_ancestor() const {
+        std::size_t id = context_id<T>();
+        if (id < inherited_.size() && inherited_[id].resolved) {
+            return static_cast<T *>(inherited_[id].context);
+        }
+
+        T *context = nullptr;
         if (auto parent = parent_.lock()) {
-            if (auto context = parent->get_context<T>()) {
-                return context;
+            context = parent->get_context<T>();
+            if (!context) {
+                context = parent->get_context_in_ancestor<T>();
             }
+        }
 
-            return parent->get_context_in_ancestor<T>();
+        if (parallelLayouts_.load(std::memory_order_relaxed) == 0) {
+            if (id >= inherited_.size()) {
+                inherited_.resize(id + 1);
+            }
+            inherited_[id] = Inherited{context, true};
         }
 
-        return nullptr;
+        return context;
     }
 
     /// Obtains context in children recursively (excluding itself)
+    /// Note: only subtrees that hold the context are visited
     template <typename T>
         requires std::is_base_of_v<Context, T>
-    [[nodiscard]] std::shared_ptr<T> get_context_in_descendant() const {
-        for (auto child : children_) {
-            if (auto context = child->get_context<T>()) {
-                return context;
+    [[nodiscard]] T *get_context_in_descendant() const {
+        std::size_t id = context_id<T>();
+        for (const auto &child : children_) {
+            if (id >= child->holders_.size() || child->holders_[id] == 0) {
+                continue;
             }
 
-            if (auto context = child->get_context_in_descendant<T>()) {
+            if (auto context = child->get_context<T>()) {
                 return context;
             }
+
+            return child->get_context_in_descendant<T>();
         }
 
         return nullptr;
     }
 
+    /// Calls fn(node, context) for every descendant holding the context in depth-first order (excluding itself)
+    /// Note: only subtrees that hold the context are visited, the tree must not be modified meanwhile
+    template <typename T, typename Fn>
+        requires std::is_base_of_v<Context, T> && std::is_invocable_v<Fn &, Node &, T &>
+    void for_each_with_context(Fn &&fn) const {
+        std::size_t id = context_id<T>();
+        for (const auto &child : children_) {
+            if (id >= child->holders_.size() || child->holders_[id] == 0) {
+                continue;
+            }
+
+            if (auto context = child->get_context<T>()) {
+                fn(*child, *context);
+            }
+
+            child->for_each_with_context<T>(fn);
+        }
+    }
+
     /// Override this for custom hit testing
     virtual bool hit_test(Vec2 position) const {
-        return contains(tMetric_.bounds, rotate_around(position, tMetric_.bounds.center, -tMetric_.rotation));
+        Vec2 local = Vec2(mr(worldToLocal_, mr(worldInv_, Vec3(position, 1.0f))));
+        Vec2 half  = abs(tMetric_.bounds.extent) * 0.5f;
+        return fabsf(local.x) <= half.x && fabsf(local.y) <= half.y;
     }
 
-    /// Override this for custom modeling after this class has been modeled
-    virtual void on_model() {}
+    /// Override this for custom modeling of the children after this class has been modeled, e.g. layouts
+    /// Note: runs within flush_layout before descending; the models of children written here do not propagate further
+    virtual void on_model(const LayoutContext &) const {}
 
     /// Override this for updating before children
     virtual void pre_update() {}
@@ -399,6 +999,8 @@ class Node : public std::enable_shared_from_this<Node> {
             return;
         }
 
+        GLARENS_ZONE_SUBJECT("update", this);
+
         pre_update();
 
         if (enableChildrenUpdate) {
@@ -416,21 +1018,8 @@ class Node : public std::enable_shared_from_this<Node> {
     /// Override this for rendering after children
     virtual void post_render() const {}
 
-    void render() const {
-        if (!enableRender) {
-            return;
-        }
-
-        pre_render();
-
-        if (enableChildrenRender) {
-            for (const auto &child : children_) {
-                child->render();
-            }
-        }
-
-        post_render();
-    }
+    /// Note: flushes layout and culls against the viewport and clip rect captured by the outermost call
+    void render() const;
 
     /// Debug rendering
     virtual void debug() const;
@@ -0,0 +1,124 @@
+// Glarens - GUI Framework.
+//
+// Scoped-zone frame profiler.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Set to 0 to compile every zone out; the functions below then do nothing
+#ifndef GLARENS_PROFILER
+#define GLARENS_PROFILER 1
+#endif
+
+/// Timed span of a zone, in nanoseconds since the profiler's epoch
+struct ProfileEvent {
+    const char   *name    = nullptr; /// Static string naming the zone
+    const void   *subject = nullptr; /// Object the zone worked on, e.g. the root of a subtree
+    std::uint64_t begin   = 0;
+    std::uint64_t end     = 0;
+    std::uint32_t depth   = 0; /// Nesting depth of the zone on its thread
+};
+
+/// Distribution of recent frame times
+struct FrameHistogram {
+    static constexpr std::size_t BUCKETS   = 32;
+    static constexpr float       BUCKET_MS = 1.0f; /// Width of a bucket, the last one collects the slower frames
+
+    std::array<std::uint32_t, BUCKETS> counts = {};
+
+    std::size_t frames = 0;
+    float       minMs  = 0.0f;
+    float       maxMs  = 0.0f;
+    float       meanMs = 0.0f;
+    float       p99Ms  = 0.0f; /// 99th percentile
+};
+
+/// Starts or stops recording zones; zones nested deeper than maxDepth are not recorded
+/// Note: each thread keeps its most recent zones in its own ring buffer
+void glarens_set_profiling(bool enable, std::uint32_t maxDepth = UINT32_MAX);
+
+/// Marks the start of a frame for the frame-time histogram, called by glarens_render()
+void glarens_mark_frame();
+
+/// Writes the buffered zones of every thread as Chrome trace_event JSON (chrome://tracing, Perfetto)
+/// Note: zones being recorded while writing may be torn; write between frames
+/// Returns false if the file could not be written
+bool glarens_write_trace(const char *path);
+
+/// Histogram of the frame times between the recent frame marks
+[[nodiscard]] FrameHistogram glarens_get_frame_histogram();
+
+/// Drops the buffered zones and frame times
+void glarens_clear_profile();
+
+#if GLARENS_PROFILER
+
+/// Records the time spent in its scope, nothing while profiling is disabled
+class ProfileZone {
+    const char   *name_;
+    const void   *subject_;
+    std::uint64_t begin_  = 0;
+    bool          active_ = false;
+
+    inline static std::atomic<bool>          enabled_  = false;
+    inline static std::atomic<std::uint32_t> maxDepth_ = UINT32_MAX;
+    inline static thread_local std::uint32_t depth_    = 0;
+
+    friend void glarens_set_profiling(bool enable, std::uint32_t maxDepth);
+    friend void glarens_mark_frame();
+
+    [[nodiscard]] static std::uint64_t now_() noexcept;
+
+    static void record_(const ProfileEvent &event) noexcept;
+
+  public:
+    explicit ProfileZone(const char *name, const void *subject = nullptr) noexcept : name_(name), subject_(subject) {
+        if (!enabled_.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        // Depth is counted past the limit so that nesting stays balanced
+        active_ = true;
+        if (depth_++ < maxDepth_.load(std::memory_order_relaxed)) {
+            begin_ = now_();
+        }
+    }
+
+    ~ProfileZone() {
+        if (!active_) {
+            return;
+        }
+
+        std::uint32_t depth = --depth_;
+        if (depth < maxDepth_.load(std::memory_order_relaxed)) {
+            record_(ProfileEvent{name_, subject_, begin_, now_(), depth});
+        }
+    }
+
+    ProfileZone(const ProfileZone &)            = delete;
+    ProfileZone &operator=(const ProfileZone &) = delete;
+};
+
+#define GLARENS_ZONE_CAT_(a, b) a##b
+#define GLARENS_ZONE_CAT(a, b)  GLARENS_ZONE_CAT_(a, b)
+
+/// Profiles the rest of the enclosing scope under a static name
+#define GLARENS_ZONE(name) ProfileZone GLARENS_ZONE_CAT(glarensZone_, __LINE__)(name)
+
+/// Profiles the rest of the enclosing scope under a static name, attributed to an object
+#define GLARENS_ZONE_SUBJECT(name, subject) ProfileZone GLARENS_ZONE_CAT(glarensZone_, __LINE__)(name, subject)
+
+#else
+
+#define GLARENS_ZONE(name)                  static_cast<void>(0)
+#define GLARENS_ZONE_SUBJECT(name, subject) static_cast<void>(0)
+
+#endif
@@ -0,0 +1,77 @@
+// Glarens - GUI Framework.
+//
+// Batched geometry rendering.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#pragma once
+
+#include "glarens/math.hpp"
+#include "glarens/node.hpp"
+#include <SDL3/SDL_render.h>
+#include <cstddef>
+#include <vector>
+
+/// Geometry copied out of a batch, replayable verbatim
+struct RenderRecording {
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int>        indices; /// Relative to the first recorded vertex
+};
+
+/// Accumulates colored geometry into one vertex and index buffer, submitted with a single SDL_RenderGeometry call
+/// Note: geometry is drawn in submission order; flush before drawing through SDL directly to keep that order
+class RenderBatch {
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int>        indices_;
+
+    std::size_t submits_    = 0; /// Number of SDL_RenderGeometry calls made
+    std::size_t generation_ = 0; /// Number of times the batch was cleared
+
+    void push_quad_(Vec2 a, Vec2 b, Vec2 c, Vec2 d, Color color);
+
+  public:
+    /// Position in the batch to record from
+    struct Mark {
+        std::size_t vertices   = 0;
+        std::size_t indices    = 0;
+        std::size_t generation = 0;
+    };
+
+    /// Filled rectangle, rotated around its center
+    void fill_rect(BoxMetric metric, Color color);
+
+    /// Rectangle outline drawn inside the edges, rotated around its center
+    void stroke_rect(BoxMetric metric, Color color, float thickness = 1.0f);
+
+    /// Line segment as a quad of the given thickness
+    void line(Vec2 from, Vec2 to, Color color, float thickness = 1.0f);
+
+    /// Filled convex quadrilateral given in winding order
+    void fill_quad(Vec2 a, Vec2 b, Vec2 c, Vec2 d, Color color);
+
+    [[nodiscard]] Mark get_mark() const noexcept {
+        return Mark{vertices_.size(), indices_.size(), generation_};
+    }
+
+    /// Copies the geometry added since the mark
+    /// Returns false if the batch was flushed or cleared since, leaving the recording untouched
+    bool record(Mark since, RenderRecording &recording) const;
+
+    /// Appends previously recorded geometry
+    void replay(const RenderRecording &recording);
+
+    /// Submits the accumulated geometry and clears the batch
+    void flush(SDL_Renderer *renderer);
+
+    void clear() noexcept;
+
+    [[nodiscard]] bool empty() const noexcept { return indices_.empty(); }
+
+    [[nodiscard]] std::size_t get_vertex_count() const noexcept { return vertices_.size(); }
+
+    [[nodiscard]] std::size_t get_index_count() const noexcept { return indices_.size(); }
+
+    [[nodiscard]] std::size_t get_submit_count() const noexcept { return submits_; }
+};
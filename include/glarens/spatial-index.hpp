@@ -0,0 +1,89 @@
+// Glarens - GUI Framework.
+//
+// Spatial index for picking.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#pragma once
+
+#include "glarens/math.hpp"
+#include "glarens/node.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/// Uniform grid over the world-space bounds of rendered nodes, for picking and region queries
+/// Results are ordered top-most first, i.e. reverse render order
+/// Note: reads world metrics, so build and refit after render() or debug(); rebuild after structural changes
+/// Note: while built, nodes record their moves for the refit
+class SpatialIndex {
+    struct Entry {
+        const Node  *node;
+        Vec2         min;      /// World-space bounding box minimum
+        Vec2         max;      /// World-space bounding box maximum
+        std::int32_t cells[4]; /// Covered cell range: x0, y0, x1, y1
+        bool         large;    /// Covers too many cells, kept in the large list instead
+    };
+
+    float cellSize_;
+
+    std::vector<Entry>                                            entries_; /// Render order
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> cells_;   /// Sorted entry indices per cell
+    std::vector<std::uint32_t>                                    large_;   /// Sorted entry indices
+    std::unordered_map<const Node *, std::uint32_t>               lookup_;  /// Entry index of each node
+
+    static constexpr std::size_t NO_READER = std::numeric_limits<std::size_t>::max();
+
+    std::size_t reader_ = NO_READER; /// Position in the journal of moved nodes, while built
+    std::size_t checks_ = 0;         /// Entries re-read by the last refit
+
+    void bound_(Entry &entry) const;
+    void insert_(std::uint32_t index);
+    void erase_(std::uint32_t index);
+
+    template <typename Fn>
+    void candidates_(Vec2 min, Vec2 max, Fn &&fn) const;
+
+  public:
+    static constexpr std::size_t LARGE_CELLS = 256; /// Entries covering more cells are not bucketed
+
+    explicit SpatialIndex(float cellSize = 64.0f) noexcept : cellSize_(cellSize > 0.0f ? cellSize : 64.0f) {}
+
+    SpatialIndex(const SpatialIndex &)            = delete;
+    SpatialIndex &operator=(const SpatialIndex &) = delete;
+
+    SpatialIndex(SpatialIndex &&index) noexcept;
+    SpatialIndex &operator=(SpatialIndex &&index) noexcept;
+
+    ~SpatialIndex();
+
+    /// Indexes every rendered node of the tree
+    void build(const std::shared_ptr<Node> &root);
+
+    /// Re-reads the bounds of indexed nodes moved since the last build or refit, re-bucketing those that changed
+    /// Returns the number of moved nodes
+    std::size_t refit();
+
+    /// Entries re-read by the last refit
+    [[nodiscard]] std::size_t get_refit_checks() const noexcept { return checks_; }
+
+    /// Top-most node whose hit test passes at the position
+    [[nodiscard]] const Node *pick(Vec2 position) const;
+
+    /// All nodes whose hit test passes at the position, top-most first
+    [[nodiscard]] std::vector<const Node *> pick_all(Vec2 position) const;
+
+    /// All nodes whose bounding box overlaps the rectangle, top-most first
+    [[nodiscard]] std::vector<const Node *> query(Rect rect) const;
+
+    void clear() noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept { return entries_.size(); }
+
+    [[nodiscard]] float get_cell_size() const noexcept { return cellSize_; }
+};
@@ -0,0 +1,165 @@
+// Glarens - GUI Framework.
+//
+// Virtualized list node.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#pragma once
+
+#include "glarens/layout.hpp"
+#include "glarens/node.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/// Shows a huge number of uniformly sized items by materializing only the visible ones
+/// Items are clones of the item prototype, recycled while scrolling and rebound with the bind callback
+// Note: children are managed by the list, do not insert or remove them manually
+class VirtualList : public Node {
+  public:
+    using Bind = std::function<void(Node &item, std::size_t index)>;
+
+  private:
+    Param<std::size_t> itemCount_  = 0;
+    Param<float>       itemExtent_ = 1.0f;           /// Extent of each item along the direction
+    Param<std::size_t> overscan_   = 2;              /// Items kept alive beyond each visible edge
+    Param<Direction>   dir_        = DIRECTION_DOWN; /// Direction of increasing item indices
+
+    std::shared_ptr<Node> itemProto_;
+    Bind                  bind_;
+    std::uint64_t         itemsVersion_ = 0; /// Changes whenever the item prototype or the bind callback is set
+
+    double scroll_ = 0.0; /// Distance scrolled along the direction, in double to stay exact far into huge lists
+
+    std::vector<std::shared_ptr<Node>> items_;          /// Materialized items, contiguous from firstIndex_
+    std::size_t                        firstIndex_ = 0; /// Index of the first materialized item
+    std::vector<std::shared_ptr<Node>> spares_;         /// Detached items waiting for reuse
+    bool                               rebind_ = true;  /// All materialized items must be rebound
+
+    void release_items_();
+    /// Places the item relative to the anchor, the item at the leading edge scrolled past by fraction
+    void place_item_(Node &item, std::size_t index, std::size_t anchor, float fraction, float viewExtent) const;
+
+  protected:
+    VirtualList() = default;
+
+  public:
+    static std::shared_ptr<VirtualList> create() {
+        return std::shared_ptr<VirtualList>(new VirtualList);
+    }
+
+    std::shared_ptr<Node> recreate() const override {
+        return std::shared_ptr<VirtualList>(new VirtualList);
+    }
+
+    void sync(const std::shared_ptr<Node> &proto) override {
+        auto list = std::dynamic_pointer_cast<VirtualList>(proto);
+        if (!list) {
+            throw std::runtime_error("Prototype of a different type cannot be used to synchronize parameters");
+        }
+
+        Node::sync(proto);
+
+        bool changed = false;
+        changed |= itemCount_.sync(list->itemCount_);
+        changed |= itemExtent_.sync(list->itemExtent_);
+        changed |= overscan_.sync(list->overscan_);
+        changed |= dir_.sync(list->dir_);
+        if (changed) {
+            rebind_ = true;
+        }
+
+        if (itemProto_ != list->itemProto_) {
+            set_item_proto(list->itemProto_);
+        }
+        bind_ = list->bind_;
+    }
+
+    [[nodiscard]] std::uint64_t get_params_version() const noexcept override {
+        return std::max({Node::get_params_version(), itemCount_.get_version(), itemExtent_.get_version(), overscan_.get_version(), dir_.get_version(), itemsVersion_});
+    }
+
+    [[nodiscard]] std::size_t get_item_count() const noexcept { return itemCount_.get(); }
+    [[nodiscard]] float       get_item_extent() const noexcept { return itemExtent_.get(); }
+    [[nodiscard]] std::size_t get_overscan() const noexcept { return overscan_.get(); }
+    [[nodiscard]] Direction   get_dir() const noexcept { return dir_.get(); }
+
+    void set_item_count(std::size_t value) {
+        itemCount_.set(value);
+        rebind_ = true;
+    }
+
+    void set_item_extent(float value) {
+        itemExtent_.set(value);
+        rebind_ = true;
+    }
+
+    void set_overscan(std::size_t value) {
+        overscan_.set(value);
+    }
+
+    void set_dir(Direction value) {
+        dir_.set(value);
+        rebind_ = true;
+    }
+
+    /// Note: drops all materialized items
+    void set_item_proto(std::shared_ptr<Node> proto);
+
+    [[nodiscard]] const std::shared_ptr<Node> &get_item_proto() const noexcept {
+        return itemProto_;
+    }
+
+    void set_bind(Bind bind) {
+        bind_         = std::move(bind);
+        itemsVersion_ = next_param_version();
+        rebind_       = true;
+    }
+
+    /// Marks all materialized items for rebinding, e.g. after the underlying data changed
+    void rebind() noexcept {
+        rebind_ = true;
+    }
+
+    [[nodiscard]] double get_scroll() const noexcept {
+        return scroll_;
+    }
+
+    /// Note: clamped to the scrollable range on the next refresh
+    void set_scroll(double value) noexcept {
+        scroll_ = value;
+    }
+
+    /// Largest scroll distance for the current item count and transformed extent
+    [[nodiscard]] double get_max_scroll() const noexcept;
+
+    [[nodiscard]] std::size_t get_first_materialized() const noexcept {
+        return firstIndex_;
+    }
+
+    [[nodiscard]] std::size_t get_materialized_count() const noexcept {
+        return items_.size();
+    }
+
+    /// Materialized item showing the index, if any
+    [[nodiscard]] std::shared_ptr<Node> get_item(std::size_t index) const noexcept {
+        if (index < firstIndex_ || index - firstIndex_ >= items_.size()) {
+            return nullptr;
+        }
+        return items_[index - firstIndex_];
+    }
+
+    /// Materializes, recycles, binds and places items for the current scroll and transformed extent
+    /// Note: called automatically by update(), uses the metric of the last layout flush
+    void refresh_items();
+
+    void pre_update() override {
+        refresh_items();
+    }
+};
@@ -0,0 +1,183 @@
+// Glarens - GUI Framework.
+//
+// Flat node storage implementation.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/arena.hpp"
+#include "glarens/node.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Nodes are scattered in memory, but the arena knows which ones a pass touches next
+static constexpr std::size_t PREFETCH_DISTANCE = 8;
+static constexpr std::size_t CACHE_LINE        = 64;
+
+/// Hints the cache about a byte range, a no-op where unsupported
+static void prefetch(const void *begin, const void *end) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    for (auto address = static_cast<const char *>(begin); address < end; address += CACHE_LINE) {
+        __builtin_prefetch(address);
+    }
+#else
+    (void)begin;
+    (void)end;
+#endif
+}
+
+template <typename T>
+static void prefetch(const T &object) noexcept {
+    prefetch(&object, &object + 1);
+}
+
+void NodeArena::build(const std::shared_ptr<Node> &root) {
+    clear();
+    if (!root) {
+        return;
+    }
+
+    // Pairs of node and its parent index, children pushed in reverse to keep sibling order
+    std::vector<std::pair<const Node *, std::uint32_t>> stack;
+    stack.emplace_back(root.get(), NONE);
+
+    while (!stack.empty()) {
+        auto [node, parent] = stack.back();
+        stack.pop_back();
+
+        auto index = static_cast<std::uint32_t>(nodes_.size());
+
+        nodes_.push_back(node);
+        models_.push_back(node->model_.get());
+        tStacks_.push_back(node->tStack_.get());
+        lazy_.push_back(node->lazyTransform_);
+        mMetrics_.push_back(node->mMetric_);
+        tMetrics_.push_back(node->tMetric_);
+        childRefs_.push_back(node->childRef_);
+        parents_.push_back(parent);
+        firstChildren_.push_back(NONE);
+        nextSiblings_.push_back(NONE);
+        subtreeSizes_.push_back(1);
+
+        for (auto it = node->children_.rbegin(); it != node->children_.rend(); ++it) {
+            stack.emplace_back(it->get(), index);
+        }
+    }
+
+    // Link siblings and accumulate subtree sizes backwards, so children are complete before their parent
+    for (std::uint32_t i = static_cast<std::uint32_t>(nodes_.size()); i-- > 1;) {
+        std::uint32_t parent = parents_[i];
+
+        nextSiblings_[i]       = firstChildren_[parent];
+        firstChildren_[parent] = i;
+        subtreeSizes_[parent] += subtreeSizes_[i];
+    }
+}
+
+void NodeArena::update_models() {
+    // Ancestors of every invalidated node are marked, so clean subtrees are skipped whole
+    for (std::size_t i = 0; i < nodes_.size();) {
+        const Node *node = nodes_[i];
+
+        if (node->modelDirty_) {
+            models_[i] = node->model_.get();
+        }
+        if (node->transformDirty_) {
+            tStacks_[i] = node->tStack_.get();
+            lazy_[i]    = node->lazyTransform_;
+        }
+
+        i += node->childrenDirty_ ? 1 : subtreeSizes_[i];
+    }
+}
+
+void NodeArena::layout(const LayoutContext &context) {
+    if (nodes_.empty()) {
+        return;
+    }
+
+    BoxMetric rootMetric = BoxMetric::screen_metric(context);
+    if (auto parent = nodes_[0]->parent_.lock()) {
+        rootMetric = parent->childRef_;
+    }
+
+    for (std::size_t i = 0; i < nodes_.size(); i++) {
+        std::uint32_t parent       = parents_[i];
+        BoxMetric     parentMetric = parent != NONE ? childRefs_[parent] : rootMetric;
+
+        BoxMetric mMetric = model_box(models_[i], parentMetric, context);
+        BoxMetric tMetric = mMetric;
+        if (!tStacks_[i].empty()) {
+            tMetric = apply_transform(mMetric, compose_transform(tStacks_[i], mMetric.bounds.extent, parentMetric, context));
+        }
+
+        mMetrics_[i]  = mMetric;
+        tMetrics_[i]  = tMetric;
+        childRefs_[i] = lazy_[i] ? lazy_reference(mMetric, tMetric) : tMetric;
+
+        if (firstChildren_[i] == NONE) {
+            continue;
+        }
+
+        // Layouts read the reference and re-model their children, which come later in the arrays
+        const Node *node     = nodes_[i];
+        node->childRef_      = childRefs_[i];
+        node->childrenDirty_ = true;
+        node->on_model(context);
+        node->changedFrom_ = SIZE_MAX;
+
+        // Re-modeled children are read again before their own turn
+        if (!node->dirtyChildren_.empty()) {
+            for (std::uint32_t child = firstChildren_[i]; child != NONE; child = nextSiblings_[child]) {
+                models_[child] = nodes_[child]->model_.get();
+            }
+        }
+    }
+}
+
+void NodeArena::commit() const {
+    for (std::size_t i = 0; i < nodes_.size(); i++) {
+        if (i + PREFETCH_DISTANCE < nodes_.size()) {
+            const Node *next = nodes_[i + PREFETCH_DISTANCE];
+            prefetch(next->mMetric_);
+            prefetch(next->tMetric_);
+            prefetch(next->localToWorld_);
+            prefetch(next->worldToLocal_);
+            prefetch(next->childRef_);
+            prefetch(next->lazy_);
+            prefetch(next->composedStale_);
+            prefetch(next->modelDirty_);
+            prefetch(next->dirtyChildren_);
+        }
+
+        const Node *node = nodes_[i];
+
+        node->mMetric_ = mMetrics_[i];
+        node->store_t_metric_(tMetrics_[i]);
+
+        node->composedStale_  = true;
+        node->modelDirty_     = false;
+        node->transformDirty_ = false;
+        node->childrenDirty_  = false;
+        node->dirtyChildren_.clear();
+        node->renderDirty_    = true;
+        node->contentDirty_   = true;
+    }
+}
+
+void NodeArena::clear() noexcept {
+    nodes_.clear();
+    models_.clear();
+    tStacks_.clear();
+    lazy_.clear();
+    mMetrics_.clear();
+    tMetrics_.clear();
+    childRefs_.clear();
+    parents_.clear();
+    firstChildren_.clear();
+    nextSiblings_.clear();
+    subtreeSizes_.clear();
+}
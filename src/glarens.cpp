@@ -10,13 +10,223 @@
 
 #include "glarens/glarens.hpp"
 #include "internal/app-data.hpp"
+#include "internal/thread-pool.hpp"
+#include <SDL3/SDL_blendmode.h>
+#include <SDL3/SDL_pixels.h>
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+#include <SDL3/SDL_surface.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+static void fill_background(SDL_Renderer *renderer, Color background) {
+    std::uint8_t  r, g, b, a;
+    SDL_BlendMode mode;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_GetRenderDrawBlendMode(renderer, &mode);
+
+    // Unlike SDL_RenderClear, filling respects the clip rect
+    SDL_SetRenderDrawColor(renderer, background.r, background.g, background.b, background.a);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    SDL_RenderFillRect(renderer, nullptr);
+
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    SDL_SetRenderDrawBlendMode(renderer, mode);
+}
+
+static void draw(const std::shared_ptr<Node> &root, bool debug) {
+    if (debug) {
+        root->debug();
+    } else {
+        root->render();
+    }
+}
+
+static void release_backbuffer() {
+    if (appData.backbuffer) {
+        SDL_DestroyTexture(appData.backbuffer);
+        appData.backbuffer = nullptr;
+    }
+}
+
+/// Makes sure the backbuffer matches the output size, damaging everything when it is (re)created
+static bool prepare_backbuffer(SDL_Renderer *renderer) {
+    int width = 0, height = 0;
+    if (!SDL_GetCurrentRenderOutputSize(renderer, &width, &height)) {
+        return false;
+    }
+
+    float currentWidth = 0.0f, currentHeight = 0.0f;
+    if (appData.backbuffer && SDL_GetTextureSize(appData.backbuffer, &currentWidth, &currentHeight) && currentWidth == width && currentHeight == height) {
+        return true;
+    }
+
+    release_backbuffer();
+    appData.backbuffer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!appData.backbuffer) {
+        return false;
+    }
+
+    SDL_SetTextureBlendMode(appData.backbuffer, SDL_BLENDMODE_NONE);
+    appData.damage.add_full();
+    return true;
+}
 
 void glarens_init(SDL_Window *window, SDL_Renderer *renderer) {
     appData.window   = window;
     appData.renderer = renderer;
+    appData.viewport = Vec2(0.0f, 0.0f);
+    appData.dpiScale = 1.0f;
+}
+
+bool glarens_init_headless(Vec2 viewport, float dpiScale) {
+    auto width  = static_cast<int>(std::ceil(viewport.x));
+    auto height = static_cast<int>(std::ceil(viewport.y));
+
+    SDL_Surface *surface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        return false;
+    }
+
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    if (!renderer) {
+        SDL_DestroySurface(surface);
+        return false;
+    }
+
+    glarens_init(nullptr, renderer);
+    appData.viewport        = viewport;
+    appData.dpiScale        = dpiScale > 0.0f ? dpiScale : 1.0f;
+    appData.headlessSurface = surface;
+    return true;
+}
+
+SDL_Surface *glarens_get_headless_surface() {
+    return appData.headlessSurface;
 }
 
 void glarens_term() {
+    appData.layoutPool.reset();
+    appData.batch.clear();
+    appData.damage.enabled = false;
+    release_backbuffer();
+    appData.layers.clear();
+
+    // Textures are gone, the owned renderer can go
+    if (appData.headlessSurface) {
+        SDL_DestroyRenderer(appData.renderer);
+        SDL_DestroySurface(appData.headlessSurface);
+        appData.headlessSurface = nullptr;
+    }
+
     appData.window   = nullptr;
     appData.renderer = nullptr;
+    appData.viewport = Vec2(0.0f, 0.0f);
+    appData.dpiScale = 1.0f;
+}
+
+void glarens_set_layout_threads(std::size_t threadCount) {
+    appData.layoutPool.reset();
+    if (threadCount >= 2) {
+        appData.layoutPool = std::make_unique<ThreadPool>(threadCount);
+    }
+}
+
+void glarens_set_layout_threshold(std::size_t nodeCount) {
+    appData.layoutThreshold = nodeCount;
+}
+
+void glarens_set_partial_redraw(bool enable) {
+    appData.damage.enabled = enable;
+    appData.damage.add_full();
+    if (!enable) {
+        release_backbuffer();
+    }
+}
+
+void glarens_damage_all() {
+    appData.damage.add_full();
+}
+
+void glarens_set_invalidation_tracking(bool enable) {
+    appData.invalidations.enabled.store(enable, std::memory_order_relaxed);
+}
+
+std::vector<InvalidationOffender> glarens_get_invalidation_offenders(std::size_t count) {
+    std::vector<InvalidationOffender> offenders;
+    for (auto &node : appData.invalidations.get_nodes()) {
+        InvalidationStats stats = node->get_invalidation_stats();
+        offenders.push_back(InvalidationOffender{std::move(node), stats});
+    }
+
+    auto cost = [](const InvalidationOffender &offender) { return offender.stats.recomputes + offender.stats.touched; };
+    std::sort(offenders.begin(), offenders.end(), [&cost](const InvalidationOffender &a, const InvalidationOffender &b) { return cost(a) > cost(b); });
+    if (offenders.size() > count) {
+        offenders.resize(count);
+    }
+    return offenders;
+}
+
+void glarens_reset_invalidation_stats() {
+    appData.invalidations.reset();
+}
+
+void glarens_set_layer_budget(std::size_t bytes) {
+    appData.layers.set_budget(bytes);
+}
+
+std::size_t glarens_get_layer_usage() {
+    return appData.layers.get_bytes();
+}
+
+void glarens_render(const std::shared_ptr<Node> &root, Color background, bool debug) {
+    SDL_Renderer *renderer = appData.renderer;
+    if (!renderer || !root) {
+        return;
+    }
+
+    glarens_mark_frame();
+    GLARENS_ZONE_SUBJECT("frame", root.get());
+
+    if (!appData.damage.enabled || !prepare_backbuffer(renderer)) {
+        fill_background(renderer, background);
+        draw(root, debug);
+        return;
+    }
+
+    // Lay out and place everything first, so all damage of this frame is known before drawing
+    root->flush_layout();
+    root->place_descendants();
+
+    if (!appData.damage.empty()) {
+        SDL_Texture *target = SDL_GetRenderTarget(renderer);
+        SDL_SetRenderTarget(renderer, appData.backbuffer);
+
+        if (!appData.damage.is_full()) {
+            Rect     region = appData.damage.get();
+            Vec2     lo     = floor(region.center - region.extent * 0.5f);
+            Vec2     hi     = ceil(region.center + region.extent * 0.5f);
+            SDL_Rect clip   = {int(lo.x), int(lo.y), int(hi.x - lo.x), int(hi.y - lo.y)};
+            SDL_SetRenderClipRect(renderer, &clip);
+        }
+
+        // Damage caused while drawing is left for the next frame
+        appData.damage.reset();
+
+        fill_background(renderer, background);
+        draw(root, debug);
+
+        SDL_SetRenderClipRect(renderer, nullptr);
+        SDL_SetRenderTarget(renderer, target);
+    }
+
+    SDL_RenderTexture(renderer, appData.backbuffer, nullptr, nullptr);
+}
+
+RenderBatch &glarens_get_batch() {
+    return appData.batch;
 }
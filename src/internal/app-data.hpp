@@ -8,8 +8,18 @@
 
 #pragma once
 
+#include "glarens/math.hpp"
+#include "glarens/render-batch.hpp"
+#include "internal/damage.hpp"
+#include "internal/invalidations.hpp"
+#include "internal/layer-cache.hpp"
+#include "internal/moves.hpp"
+#include "internal/thread-pool.hpp"
 #include <SDL3/SDL_render.h>
+#include <SDL3/SDL_surface.h>
 #include <SDL3/SDL_video.h>
+#include <cstddef>
+#include <memory>
 
 #ifndef APPDATA_GLOBAL
 #define APPDATA_GLOBAL extern
@@ -18,4 +28,22 @@
 APPDATA_GLOBAL struct AppData {
     SDL_Window   *window;
     SDL_Renderer *renderer;
+
+    Vec2         viewport;                  /// Virtual viewport size, used for layout without a window
+    float        dpiScale        = 1.0f;    /// Virtual display scale, used for layout without a window
+    SDL_Surface *headlessSurface = nullptr; /// Target of the software renderer owned in headless mode
+
+    std::unique_ptr<ThreadPool> layoutPool;           /// Workers for parallel layout, serial if empty
+    std::size_t                 layoutThreshold = 64; /// Minimum subtree size to lay out on a worker
+
+    RenderBatch batch; /// Geometry of the current render pass, flushed when the outermost traversal ends
+
+    Damage       damage;               /// Regions to redraw in the backbuffer
+    SDL_Texture *backbuffer = nullptr; /// Previous frame, kept while partial redraw is enabled
+
+    MoveJournal moves; /// Nodes whose world bounds changed, while some spatial index is built
+
+    LayerCache layers; /// Textures of layer nodes, within a memory budget
+
+    InvalidationTracker invalidations; /// Per-node invalidation accounting, while enabled
 } appData;
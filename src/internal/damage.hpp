@@ -0,0 +1,64 @@
+// Glarens - GUI Framework.
+//
+// Internal damage tracking.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#pragma once
+
+#include "glarens/math.hpp"
+#include <cmath>
+#include <mutex>
+
+/// Union of regions needing redraw since the last frame, in render coordinates
+/// Note: regions may be added from layout worker threads
+class Damage {
+    std::mutex mutex_;
+
+    Vec2 min_  = Vec2(INFINITY, INFINITY);
+    Vec2 max_  = Vec2(-INFINITY, -INFINITY);
+    bool full_ = true;
+
+  public:
+    bool enabled = false; /// Regions are only accumulated while partial redraw is enabled
+
+    void add(Rect rect) {
+        if (!enabled || !(rect.extent.x > 0.0f && rect.extent.y > 0.0f)) {
+            return;
+        }
+
+        std::lock_guard lock(mutex_);
+        min_ = min(min_, rect.center - rect.extent * 0.5f);
+        max_ = max(max_, rect.center + rect.extent * 0.5f);
+    }
+
+    void add_full() {
+        std::lock_guard lock(mutex_);
+        full_ = true;
+    }
+
+    [[nodiscard]] bool is_full() {
+        std::lock_guard lock(mutex_);
+        return full_;
+    }
+
+    [[nodiscard]] bool empty() {
+        std::lock_guard lock(mutex_);
+        return !full_ && !(min_.x <= max_.x && min_.y <= max_.y);
+    }
+
+    /// Bounds of all damaged regions
+    [[nodiscard]] Rect get() {
+        std::lock_guard lock(mutex_);
+        return Rect((min_ + max_) * 0.5f, max_ - min_);
+    }
+
+    void reset() {
+        std::lock_guard lock(mutex_);
+        min_  = Vec2(INFINITY, INFINITY);
+        max_  = Vec2(-INFINITY, -INFINITY);
+        full_ = false;
+    }
+};
@@ -0,0 +1,82 @@
+// Glarens - GUI Framework.
+//
+// Internal invalidation accounting.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#pragma once
+
+#include "glarens/node.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <source_location>
+#include <vector>
+
+/// Counters of a tracked node
+/// Note: recomputes and touched are counted from layout worker threads, and so are invalidations, reason and where
+/// when layouts re-model their children
+struct InvalidationCounters {
+    std::atomic<std::uint64_t> invalidations = 0;
+    std::atomic<std::uint64_t> recomputes    = 0;
+    std::atomic<std::uint64_t> touched       = 0;
+
+    InvalidationReason   reason = INVALIDATION_NONE; /// During flush, written only by the thread laying out the parent; read only outside flush
+    std::source_location where;                      /// Same as reason
+};
+
+/// Nodes with counters, and the highest cost among them for scaling the heat map
+class InvalidationTracker {
+    struct Entry {
+        std::weak_ptr<const Node>             node;
+        std::shared_ptr<InvalidationCounters> counters;
+    };
+
+    std::mutex         mutex_;
+    std::vector<Entry> entries_;
+
+  public:
+    std::atomic<bool>          enabled = false;
+    std::atomic<std::uint64_t> peak    = 0; /// Highest recomputes + touched of a node since the last reset
+
+    void add(std::weak_ptr<const Node> node, std::shared_ptr<InvalidationCounters> counters) {
+        std::lock_guard lock(mutex_);
+        entries_.push_back(Entry{std::move(node), std::move(counters)});
+    }
+
+    /// Live tracked nodes, dropping the expired ones
+    [[nodiscard]] std::vector<std::shared_ptr<const Node>> get_nodes() {
+        std::lock_guard lock(mutex_);
+
+        std::vector<std::shared_ptr<const Node>> nodes;
+        std::erase_if(entries_, [&nodes](const Entry &entry) {
+            auto node = entry.node.lock();
+            if (node) {
+                nodes.push_back(std::move(node));
+            }
+            return !node;
+        });
+        return nodes;
+    }
+
+    /// Zeroes the counters of every tracked node
+    void reset() {
+        std::lock_guard lock(mutex_);
+        for (const Entry &entry : entries_) {
+            entry.counters->invalidations.store(0, std::memory_order_relaxed);
+            entry.counters->recomputes.store(0, std::memory_order_relaxed);
+            entry.counters->touched.store(0, std::memory_order_relaxed);
+        }
+        peak.store(0, std::memory_order_relaxed);
+    }
+
+    /// Raises the peak to the cost if higher
+    void raise_peak(std::uint64_t cost) noexcept {
+        std::uint64_t current = peak.load(std::memory_order_relaxed);
+        while (cost > current && !peak.compare_exchange_weak(current, cost, std::memory_order_relaxed)) {
+        }
+    }
+};
@@ -0,0 +1,56 @@
+// Glarens - GUI Framework.
+//
+// Internal layer texture cache.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#pragma once
+
+#include <SDL3/SDL_render.h>
+#include <cstddef>
+#include <list>
+
+/// Render target texture of a layer node, owned by the node and tracked by the cache
+struct LayerTexture {
+    SDL_Texture *texture = nullptr;
+    int          width   = 0;
+    int          height  = 0;
+    bool         pinned  = false; /// Being drawn into, must not be evicted
+
+    bool                                linked = false; /// Tracked by the cache
+    std::list<LayerTexture *>::iterator lru;            /// Position in the cache's recency list
+
+    LayerTexture() = default;
+
+    LayerTexture(const LayerTexture &)            = delete;
+    LayerTexture &operator=(const LayerTexture &) = delete;
+
+    ~LayerTexture();
+};
+
+/// Keeps layer textures within a memory budget, evicting the least recently used ones
+class LayerCache {
+    std::list<LayerTexture *> lru_; /// Most recently used first
+
+    std::size_t bytes_  = 0;
+    std::size_t budget_ = 64 * 1024 * 1024;
+
+    void evict_(std::size_t needed);
+
+  public:
+    /// Makes sure the layer has a texture of the size, unless it does not fit the budget
+    /// Returns whether the texture was (re)created, i.e. its contents are undefined
+    bool acquire(SDL_Renderer *renderer, LayerTexture &layer, int width, int height);
+
+    /// Destroys the texture of the layer and stops tracking it
+    void release(LayerTexture &layer) noexcept;
+
+    void set_budget(std::size_t bytes);
+
+    [[nodiscard]] std::size_t get_bytes() const noexcept { return bytes_; }
+
+    /// Destroys every texture, e.g. before the renderer goes away
+    void clear() noexcept;
+};
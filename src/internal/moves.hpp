@@ -0,0 +1,88 @@
+// Glarens - GUI Framework.
+//
+// Internal journal of moved nodes.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+class Node;
+
+/// Nodes whose world bounds changed, read by spatial indices to refit only what moved
+/// Each reader sees the nodes recorded since it last read, nodes read by every reader are dropped
+/// Note: nodes may be added from layout worker threads
+class MoveJournal {
+    static constexpr std::uint64_t CLOSED = std::numeric_limits<std::uint64_t>::max();
+
+    std::mutex mutex_;
+
+    std::vector<const Node *>  nodes_;
+    std::uint64_t              first_ = 0; /// Sequence number of the first kept node
+    std::vector<std::uint64_t> readers_;   /// Sequence number each reader continues from, CLOSED if unused
+
+    std::atomic<std::size_t> open_ = 0; /// Nodes are only recorded while some reader is open
+
+    void trim_() {
+        std::uint64_t oldest = CLOSED;
+        for (std::uint64_t reader : readers_) {
+            oldest = std::min(oldest, reader);
+        }
+
+        std::uint64_t end = first_ + nodes_.size();
+        oldest            = std::min(oldest, end);
+        nodes_.erase(nodes_.begin(), nodes_.begin() + static_cast<std::ptrdiff_t>(oldest - first_));
+        first_ = oldest;
+    }
+
+  public:
+    void add(const Node *node) {
+        if (open_.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+
+        std::lock_guard lock(mutex_);
+        nodes_.push_back(node);
+    }
+
+    /// Starts a reader at the current end of the journal
+    [[nodiscard]] std::size_t open() {
+        std::lock_guard lock(mutex_);
+        open_++;
+
+        auto free = std::find(readers_.begin(), readers_.end(), CLOSED);
+        if (free == readers_.end()) {
+            free = readers_.insert(free, CLOSED);
+        }
+        *free = first_ + nodes_.size();
+        return static_cast<std::size_t>(free - readers_.begin());
+    }
+
+    void close(std::size_t reader) {
+        std::lock_guard lock(mutex_);
+        open_--;
+        readers_[reader] = CLOSED;
+        trim_();
+    }
+
+    /// Nodes recorded since the reader last read, in recording order and possibly repeated
+    [[nodiscard]] std::vector<const Node *> read(std::size_t reader) {
+        std::lock_guard lock(mutex_);
+
+        auto begin = nodes_.begin() + static_cast<std::ptrdiff_t>(readers_[reader] - first_);
+        std::vector<const Node *> nodes(begin, nodes_.end());
+
+        readers_[reader] = first_ + nodes_.size();
+        trim_();
+        return nodes;
+    }
+};
@@ -0,0 +1,71 @@
+// Glarens - GUI Framework.
+//
+// Work-stealing thread pool.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Each worker owns a deque; owners pop from the back, thieves steal from the front
+class ThreadPool {
+  public:
+    /// Set of tasks that can be waited on together
+    class Group {
+        friend class ThreadPool;
+
+        std::atomic<std::size_t> pending_ = 0;
+        std::mutex               errorMutex_;
+        std::exception_ptr       error_;
+    };
+
+  private:
+    struct Task {
+        std::function<void()> fn;
+        Group                 *group = nullptr;
+    };
+
+    struct Worker {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread>             threads_;
+
+    std::mutex              sleepMutex_;
+    std::condition_variable wake_;
+    std::atomic<std::size_t> queued_ = 0;
+    std::atomic<bool>        stop_   = false;
+    std::atomic<std::size_t> next_   = 0;
+
+    bool try_run_one_(std::size_t self);
+    void run_(Task &task);
+    void work_(std::size_t self);
+
+  public:
+    explicit ThreadPool(std::size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &)            = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void submit(Group &group, std::function<void()> fn);
+
+    /// Runs queued tasks on the calling thread until the group is done; rethrows the first task exception
+    void wait(Group &group);
+
+    [[nodiscard]] std::size_t get_thread_count() const noexcept { return threads_.size(); }
+};
@@ -0,0 +1,90 @@
+// Glarens - GUI Framework.
+//
+// Layer texture cache implementation.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "internal/layer-cache.hpp"
+#include "internal/app-data.hpp"
+#include <SDL3/SDL_blendmode.h>
+#include <SDL3/SDL_pixels.h>
+#include <SDL3/SDL_render.h>
+#include <cstddef>
+#include <iterator>
+
+LayerTexture::~LayerTexture() {
+    appData.layers.release(*this);
+}
+
+void LayerCache::evict_(std::size_t needed) {
+    // Walk from the least recently used end, skipping layers being drawn into
+    auto it = lru_.end();
+    while (it != lru_.begin() && bytes_ + needed > budget_) {
+        LayerTexture *layer = *--it;
+        if (layer->pinned) {
+            continue;
+        }
+
+        it = std::next(it);
+        release(*layer);
+    }
+}
+
+bool LayerCache::acquire(SDL_Renderer *renderer, LayerTexture &layer, int width, int height) {
+    if (layer.texture && layer.width == width && layer.height == height) {
+        lru_.splice(lru_.begin(), lru_, layer.lru);
+        return false;
+    }
+
+    release(layer);
+
+    auto needed = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4;
+    if (needed > budget_) {
+        return false;
+    }
+
+    evict_(needed);
+
+    layer.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!layer.texture) {
+        return false;
+    }
+
+    // Contents are drawn over transparency with regular blending, leaving premultiplied colors
+    SDL_SetTextureBlendMode(layer.texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+
+    layer.width  = width;
+    layer.height = height;
+    layer.linked = true;
+    layer.lru    = lru_.insert(lru_.begin(), &layer);
+    bytes_ += needed;
+    return true;
+}
+
+void LayerCache::release(LayerTexture &layer) noexcept {
+    if (!layer.linked) {
+        return;
+    }
+
+    SDL_DestroyTexture(layer.texture);
+    bytes_ -= static_cast<std::size_t>(layer.width) * static_cast<std::size_t>(layer.height) * 4;
+    lru_.erase(layer.lru);
+
+    layer.texture = nullptr;
+    layer.width   = 0;
+    layer.height  = 0;
+    layer.linked  = false;
+}
+
+void LayerCache::set_budget(std::size_t bytes) {
+    budget_ = bytes;
+    evict_(0);
+}
+
+void LayerCache::clear() noexcept {
+    while (!lru_.empty()) {
+        release(*lru_.front());
+    }
+}
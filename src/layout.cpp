@@ -0,0 +1,353 @@
+// Glarens - GUI Framework.
+//
+// Layout nodes implementation.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/layout.hpp"
+#include "glarens/math.hpp"
+#include "glarens/node.hpp"
+#include "glarens/profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+static constexpr float WRAP_EPSILON = 1.0e-3f; /// Tolerance of the line extent before an item wraps
+
+static float &component(Vec2 &v, int axis) noexcept {
+    return axis == 0 ? v.x : v.y;
+}
+
+/// 0 for the x axis, 1 for the y axis
+static int axis_of(Direction dir) noexcept {
+    return dir == DIRECTION_LEFT || dir == DIRECTION_RIGHT ? 0 : 1;
+}
+
+/// Runs towards negative coordinates
+static bool is_reversed(Direction dir) noexcept {
+    return dir == DIRECTION_LEFT || dir == DIRECTION_UP;
+}
+
+/// Offset of the first item and the gap between items
+struct Spread {
+    float offset = 0.0f;
+    float gap    = 0.0f;
+};
+
+/// Distributes the free space of an axis between count items
+static Spread spread(Align align, float free, std::size_t count) noexcept {
+    bool spacing = align == ALIGN_SPACE_BETWEEN || align == ALIGN_SPACE_EQUALLY || align == ALIGN_SPACE_AROUND;
+    if (spacing && count < 2) {
+        align = ALIGN_CENTER;
+    }
+
+    // Overflowing items cannot be spaced apart
+    if (spacing && free < 0.0f) {
+        align = align == ALIGN_SPACE_BETWEEN ? ALIGN_BEGIN : ALIGN_CENTER;
+    }
+
+    auto n = static_cast<float>(count);
+    switch (align) {
+    case ALIGN_BEGIN: return Spread{0.0f, 0.0f};
+    case ALIGN_CENTER: return Spread{free / 2.0f, 0.0f};
+    case ALIGN_END: return Spread{free, 0.0f};
+    case ALIGN_SPACE_BETWEEN: return Spread{0.0f, free / (n - 1.0f)};
+    case ALIGN_SPACE_EQUALLY: return Spread{free / (n + 1.0f), free / (n + 1.0f)};
+    case ALIGN_SPACE_AROUND: return Spread{free / (2.0f * n), free / n};
+    }
+    return Spread{};
+}
+
+static bool same_dim(const BoxDim &a, const BoxDim &b) noexcept {
+    return a.pos == b.pos && a.anchor == b.anchor && a.floating == b.floating && a.size == b.size && a.scale == b.scale &&
+           a.positioningRefMode == b.positioningRefMode && a.sizingRefMode == b.sizingRefMode;
+}
+
+/// Written models have no limits, so the current one matches only without any
+static bool same_model(const BoxModel &current, const BoxModel &written) noexcept {
+    return same_dim(current, written) && !current.min && !current.max;
+}
+
+void FlexLayout::on_model(const LayoutContext &context) const {
+    GLARENS_ZONE_SUBJECT("flex", this);
+
+    const auto &children = get_children();
+    BoxMetric   ref      = get_child_reference();
+    Vec2        extent   = abs(ref.bounds.extent);
+
+    int  main         = axis_of(dir_.get());
+    int  cross        = axis_of(wrapDir_.get());
+    bool crossReverse = is_reversed(wrapDir_.get());
+    if (cross == main) {
+        cross        = 1 - main;
+        crossReverse = false;
+    }
+
+    float mainLength  = component(extent, main);
+    float crossLength = component(extent, cross);
+    bool  wrapping    = doWrapping_.get();
+
+    // Resolve the items and break them into lines
+    items_.resize(children.size());
+    lines_.clear();
+
+    Line line;
+    for (std::size_t i = 0; i < children.size(); i++) {
+        const Node &child = *children[i];
+        Item       &item  = items_[i];
+
+        // A model version other than the one written here means someone else has modeled the child
+        auto [it, inserted] = bases_.try_emplace(&child);
+        if (inserted || it->second.version != child.get_model_version()) {
+            it->second.model = child.get_model();
+        }
+
+        Vec2 basis = abs(model_box(it->second.model, ref, context).bounds.extent);
+        item.basis = &it->second;
+        item.main  = component(basis, main);
+        item.cross = component(basis, cross);
+
+        const FlexItem *flex = child.get_context<FlexItem>();
+        item.weight          = flex ? std::max(flex->get_weight(), 0.0f) : 0.0f;
+        item.wrapWeight      = flex ? std::max(flex->get_wrap_weight(), 0.0f) : 0.0f;
+
+        if (wrapping && line.count > 0 && line.main + item.main > mainLength + WRAP_EPSILON) {
+            lines_.push_back(line);
+            line = Line{.first = i};
+        }
+
+        line.count++;
+        line.main += item.main;
+        line.weight += item.weight;
+        line.cross      = std::max(line.cross, item.cross);
+        line.wrapWeight = std::max(line.wrapWeight, item.wrapWeight);
+    }
+
+    if (line.count > 0) {
+        lines_.push_back(line);
+    }
+
+    // Grow the lines into the free space along the wrapping direction, or align them
+    float crossFree   = crossLength;
+    float wrapWeights = 0.0f;
+    for (const Line &l : lines_) {
+        crossFree -= l.cross;
+        wrapWeights += l.wrapWeight;
+    }
+
+    if (crossFree > 0.0f && wrapWeights > 0.0f) {
+        for (Line &l : lines_) {
+            l.cross += crossFree * l.wrapWeight / wrapWeights;
+        }
+        crossFree = 0.0f;
+    }
+
+    Spread lineSpread = spread(wrapAlign_.get(), crossFree, lines_.size());
+    float  crossPos   = lineSpread.offset;
+
+    for (std::size_t l = 0; l < lines_.size(); l++) {
+        const Line &current = lines_[l];
+
+        float mainFree = mainLength - current.main;
+        float grow     = 0.0f;
+        if (mainFree > 0.0f && current.weight > 0.0f) {
+            grow     = mainFree / current.weight;
+            mainFree = 0.0f;
+        }
+
+        Spread itemSpread  = spread(align_.get(), mainFree, current.count);
+        float  mainPos     = itemSpread.offset;
+        bool   alternate   = altWrapping_.get() && l % 2 == 1;
+        bool   mainReverse = is_reversed(dir_.get()) != alternate;
+
+        for (std::size_t i = current.first; i < current.first + current.count; i++) {
+            Item &item  = items_[i];
+            Node &child = *children[i];
+
+            float size = item.main + item.weight * grow;
+
+            // Slots are placed from the beginning edge, then mapped to the center-relative reference
+            float mainCenter  = mainPos + size / 2.0f - mainLength / 2.0f;
+            float crossCenter = crossPos + current.cross / 2.0f - crossLength / 2.0f;
+            mainPos += size + itemSpread.gap;
+
+            BoxModel model;
+            component(model.pos, main)   = mainReverse ? -mainCenter : mainCenter;
+            component(model.pos, cross)  = crossReverse ? -crossCenter : crossCenter;
+            component(model.size, main)  = size;
+            component(model.size, cross) = current.cross;
+
+            // The layout is still marked dirty, so these do not propagate past it
+            if (!same_model(child.get_model(), model)) {
+                child.set_model(model);
+            }
+            item.basis->version = child.get_model_version();
+        }
+
+        crossPos += current.cross + lineSpread.gap;
+    }
+
+    // Forget removed children once they dominate the bases
+    if (bases_.size() > children.size() * 2 + 16) {
+        std::unordered_map<const Node *, Basis> kept;
+        kept.reserve(children.size());
+        for (const auto &child : children) {
+            kept.emplace(child.get(), bases_.at(child.get()));
+        }
+        bases_ = std::move(kept);
+    }
+}
+
+std::uint64_t GridLayout::get_params_version_() const noexcept {
+    return std::max({dir_.get_version(), wrapDir_.get_version(), align_.get_version(), wrapAlign_.get_version(), slots_.get_version(), masonry_.get_version()});
+}
+
+void GridLayout::on_model(const LayoutContext &context) const {
+    GLARENS_ZONE_SUBJECT("grid", this);
+
+    const auto &children = get_children();
+    BoxMetric   ref      = get_child_reference();
+    Vec2        extent   = abs(ref.bounds.extent);
+
+    int  main         = axis_of(dir_.get());
+    int  cross        = axis_of(wrapDir_.get());
+    bool mainReverse  = is_reversed(dir_.get());
+    bool crossReverse = is_reversed(wrapDir_.get());
+    if (cross == main) {
+        cross        = 1 - main;
+        crossReverse = false;
+    }
+
+    auto  slots       = static_cast<std::size_t>(std::max(slots_.get(), 1));
+    float mainLength  = component(extent, main);
+    float crossLength = component(extent, cross);
+    float slotExtent  = mainLength / static_cast<float>(slots);
+    bool  masonry     = masonry_.get();
+
+    // Placements before the first changed item stand, unless something every placement depends on has changed
+    std::size_t   from    = 0;
+    std::uint64_t version = get_params_version_();
+    if (!cursors_.empty() && extent == placedExtent_ && context.viewport == placedViewport_ && version == placedVersion_) {
+        from = std::min({children.size(), placements_.size(), get_first_changed_child()});
+
+        // Only the children recorded as dirty can have been modeled by others, inserted ones are past the placements
+        for (const Node *child : get_dirty_children()) {
+            auto it = bases_.find(child);
+            if (it == bases_.end() || it->second.index >= from || placements_[it->second.index].child != child) {
+                continue;
+            }
+
+            const Placement &placement = placements_[it->second.index];
+            const GridItem  *item      = child->get_context<GridItem>();
+            if (placement.version != child->get_model_version() || placement.item != item || (item && placement.itemVersion != item->get_version())) {
+                from = it->second.index;
+            }
+        }
+    } else {
+        cursors_.assign(1, Cursor{});
+        heights_.assign(slots, 0.0f);
+    }
+
+    placedExtent_   = extent;
+    placedViewport_ = context.viewport;
+    placedVersion_  = version;
+
+    placements_.resize(children.size());
+    cursors_.resize(children.size() + 1);
+    heights_.resize((children.size() + 1) * slots);
+
+    for (std::size_t i = from; i < children.size(); i++) {
+        Node &child = *children[i];
+
+        // A model version other than the one written here means someone else has modeled the child
+        auto [it, inserted] = bases_.try_emplace(&child);
+        if (inserted || it->second.version != child.get_model_version()) {
+            it->second.model = child.get_model();
+        }
+
+        Vec2            basis = abs(model_box(it->second.model, ref, context).bounds.extent);
+        const GridItem *item  = child.get_context<GridItem>();
+
+        std::size_t span      = std::min(static_cast<std::size_t>(std::max(item ? item->get_x_span() : 1, 1)), slots);
+        int         crossSpan = std::max(item ? item->get_y_span() : 1, 1);
+        float       mainFill  = item ? std::clamp(item->get_x_weight(), 0.0f, 1.0f) : 1.0f;
+        float       crossFill = item ? std::clamp(item->get_y_weight(), 0.0f, 1.0f) : 1.0f;
+        float       length    = component(basis, cross);
+        if (length <= 0.0f) {
+            length = static_cast<float>(crossSpan) * slotExtent;
+        }
+
+        // Pack against the column heights before this item, then record the heights after it
+        const float *before = &heights_[i * slots];
+        float       *after  = &heights_[(i + 1) * slots];
+        std::copy(before, before + slots, after);
+
+        Cursor      cursor = cursors_[i];
+        std::size_t slot   = 0;
+        float       top    = 0.0f;
+        if (masonry) {
+            // Leftmost run of slots with the lowest top
+            top = INFINITY;
+            for (std::size_t s = 0; s + span <= slots; s++) {
+                float runTop = *std::max_element(before + s, before + s + span);
+                if (runTop < top) {
+                    top  = runTop;
+                    slot = s;
+                }
+            }
+        } else {
+            if (cursor.slot + span > slots) {
+                cursor.slot   = 0;
+                cursor.rowTop = *std::max_element(before, before + slots);
+            }
+
+            slot = cursor.slot;
+            top  = cursor.rowTop;
+            cursor.slot += span;
+        }
+
+        std::fill(after + slot, after + slot + span, top + length);
+        cursors_[i + 1] = cursor;
+
+        // Slots are placed from the beginning edges, then mapped to the center-relative reference
+        float cellMain  = static_cast<float>(span) * slotExtent;
+        float mainSize  = cellMain * mainFill;
+        float crossSize = length * crossFill;
+
+        float mainCenter  = static_cast<float>(slot) * slotExtent + spread(align_.get(), cellMain - mainSize, 1).offset + mainSize / 2.0f - mainLength / 2.0f;
+        float crossCenter = top + spread(wrapAlign_.get(), length - crossSize, 1).offset + crossSize / 2.0f - crossLength / 2.0f;
+
+        BoxModel model;
+        component(model.pos, main)   = mainReverse ? -mainCenter : mainCenter;
+        component(model.pos, cross)  = crossReverse ? -crossCenter : crossCenter;
+        component(model.size, main)  = mainSize;
+        component(model.size, cross) = crossSize;
+
+        // The layout is still marked dirty, so these do not propagate past it
+        if (!same_model(child.get_model(), model)) {
+            child.set_model(model);
+        }
+
+        it->second.version = child.get_model_version();
+        it->second.index   = i;
+        placements_[i]     = Placement{&child, it->second.version, item, item ? item->get_version() : 0};
+    }
+
+    // Forget removed children once they dominate the bases
+    if (bases_.size() > children.size() * 2 + 16) {
+        std::unordered_map<const Node *, Basis> kept;
+        kept.reserve(children.size());
+        for (const auto &child : children) {
+            if (auto it = bases_.find(child.get()); it != bases_.end()) {
+                kept.emplace(*it);
+            }
+        }
+        bases_ = std::move(kept);
+    }
+}
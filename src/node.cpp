@@ -9,113 +9,503 @@
 #include "glarens/node.hpp"
 #include "glarens/math.hpp"
 #include "internal/app-data.hpp"
+#include "internal/invalidations.hpp"
+#include "internal/layer-cache.hpp"
+#include "internal/thread-pool.hpp"
 #include "internal/utils.hpp"
 #include <SDL3/SDL_render.h>
 #include <SDL3/SDL_video.h>
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <format>
 #include <functional>
+#include <span>
 #include <unordered_map>
 
 static int idCounter = 0;
 
+/// State shared by a render() or debug() traversal
+struct CullPass {
+    int  depth   = 0;     /// Nesting of traversal calls
+    bool culling = false; /// Region is known
+    Rect region;          /// Visible region in render coordinates
+};
+
+static thread_local CullPass cullPass;
+
+/// Enters a traversal, capturing the visible region on the outermost call
+class CullScope {
+  public:
+    explicit CullScope(const Node &node) {
+        if (cullPass.depth++ != 0) {
+            return;
+        }
+
+        node.flush_layout();
+
+        int width = 0, height = 0;
+        cullPass.culling = appData.renderer && SDL_GetCurrentRenderOutputSize(appData.renderer, &width, &height);
+        cullPass.region  = Rect::from_xywh(Vec2(0.0f, 0.0f), Vec2(width, height));
+
+        SDL_Rect clip;
+        if (cullPass.culling && SDL_RenderClipEnabled(appData.renderer) && SDL_GetRenderClipRect(appData.renderer, &clip)) {
+            cullPass.region = from_sdl_rect(clip);
+        }
+    }
+
+    CullScope(const CullScope &)            = delete;
+    CullScope &operator=(const CullScope &) = delete;
+
+    ~CullScope() {
+        if (--cullPass.depth == 0) {
+            appData.batch.flush(appData.renderer);
+        }
+    }
+
+    [[nodiscard]] static bool visible(const Node &node) noexcept {
+        if (!node.enableCulling || !cullPass.culling) {
+            return true;
+        }
+
+        Rect bounds = node.get_world_bounds();
+        Vec2 reach  = (abs(bounds.extent) + abs(cullPass.region.extent)) * 0.5f;
+        Vec2 gap    = abs(bounds.center - cullPass.region.center);
+        return gap.x <= reach.x && gap.y <= reach.y;
+    }
+};
+
 static std::unordered_map<std::size_t, float> hues;
 
-BoxMetric BoxMetric::screen_metric() {
-    int width, height;
-    SDL_GetWindowSize(appData.window, &width, &height);
-    return BoxMetric{
-        .bounds   = Rect::from_xywh(0.0f, 0.0f, width, height),
-        .rotation = 0.0f
+LayoutContext LayoutContext::capture() {
+    static std::uint64_t frameCounter = 0;
+
+    // Without a window, layout runs against the virtual viewport
+    Vec2  viewport = appData.viewport;
+    float dpiScale = appData.dpiScale;
+    if (appData.window) {
+        int width = 0, height = 0;
+        SDL_GetWindowSize(appData.window, &width, &height);
+        viewport = Vec2(width, height);
+        dpiScale = SDL_GetWindowDisplayScale(appData.window);
+    }
+
+    return LayoutContext{
+        .viewport = viewport,
+        .dpiScale = dpiScale > 0.0f ? dpiScale : 1.0f,
+        .frameId  = ++frameCounter
     };
 }
 
-BoxMetric model_dim(BoxDim dim, BoxMetric parentMetric) noexcept {
-    int width, height;
-    SDL_GetWindowSize(appData.window, &width, &height);
+Context::Context() {
+}
+
+InvalidationCounters &Node::counters_for_() const {
+    if (!counters_) {
+        counters_ = std::make_shared<InvalidationCounters>();
+        appData.invalidations.add(weak_from_this(), counters_);
+    }
+    return *counters_;
+}
+
+void Node::count_invalidation_(InvalidationReason reason, const std::source_location &where) const {
+    // Nodes under construction are not owned yet and cannot be listed
+    if (weak_from_this().expired()) {
+        return;
+    }
+
+    InvalidationCounters &counters = counters_for_();
+    counters.invalidations.fetch_add(1, std::memory_order_relaxed);
+    counters.reason = reason;
+    counters.where  = where;
+}
+
+void Node::count_recompute_(const Node *origin) const {
+    InvalidationCounters &counters   = counters_for_();
+    std::uint64_t         recomputes = counters.recomputes.fetch_add(1, std::memory_order_relaxed) + 1;
+    appData.invalidations.raise_peak(recomputes + counters.touched.load(std::memory_order_relaxed));
+
+    // The origin counted its own recompute first, unless tracking started mid-pass
+    if (origin && origin->counters_) {
+        InvalidationCounters &cause   = *origin->counters_;
+        std::uint64_t         touched = cause.touched.fetch_add(1, std::memory_order_relaxed) + 1;
+        appData.invalidations.raise_peak(touched + cause.recomputes.load(std::memory_order_relaxed));
+    }
+}
+
+InvalidationStats Node::get_invalidation_stats() const {
+    InvalidationStats stats;
+    if (counters_) {
+        stats.invalidations = counters_->invalidations.load(std::memory_order_relaxed);
+        stats.recomputes    = counters_->recomputes.load(std::memory_order_relaxed);
+        stats.touched       = counters_->touched.load(std::memory_order_relaxed);
+        stats.reason        = counters_->reason;
+        stats.where         = counters_->where;
+    }
+    return stats;
+}
+
+void Node::invalidate_model_(InvalidationReason reason, const std::source_location &where) const {
+    if (appData.invalidations.enabled.load(std::memory_order_relaxed)) {
+        count_invalidation_(reason, where);
+    }
+
+    // A node that was already dirty has been recorded by its parent
+    bool known  = needs_layout_();
+    modelDirty_ = true;
+    if (!known) {
+        propagate_dirty_();
+    }
+}
+
+void Node::invalidate_transform_(InvalidationReason reason, const std::source_location &where) const {
+    if (appData.invalidations.enabled.load(std::memory_order_relaxed)) {
+        count_invalidation_(reason, where);
+    }
+
+    bool known      = needs_layout_();
+    transformDirty_ = true;
+    composedStale_  = true;
+    if (!known) {
+        propagate_dirty_();
+    }
+}
+
+void Node::refresh_layout(const std::source_location &where) const {
+    if (appData.invalidations.enabled.load(std::memory_order_relaxed)) {
+        count_invalidation_(INVALIDATION_REFRESH, where);
+    }
+
+    changedFrom_ = 0;
+    invalidate_children_();
+}
+
+void Node::propagate_dirty_() const {
+    if (auto parent = parent_.lock()) {
+        parent->mark_child_dirty_(this);
+    }
+}
+
+void Node::mark_child_dirty_(const Node *child) const {
+    dirtyChildren_.push_back(child);
+    invalidate_children_();
+}
+
+void Node::invalidate_children_() const {
+    // Ancestors of a node with dirty children already know about it
+    if (childrenDirty_) {
+        return;
+    }
 
-    Vec2 screen  = Vec2(width, height);
-    Vec2 refPos  = dim.positioningRefMode == REF_MODE_ABSOLUTE ? screen / 2.0f : parentMetric.bounds.center;
-    Vec2 refSize = dim.sizingRefMode == REF_MODE_ABSOLUTE ? screen : parentMetric.bounds.extent;
+    bool known     = modelDirty_ || transformDirty_;
+    childrenDirty_ = true;
+    if (!known) {
+        propagate_dirty_();
+    }
+}
 
-    Vec2 finalSize = dim.size + dim.scale * refSize;
-    Vec2 finalPos  = dim.pos + refPos + dim.anchor * refSize + dim.floating * finalSize;
+void Node::adjust_subtree_size_(std::ptrdiff_t delta) {
+    subtreeSize_ += delta;
+    for (auto parent = parent_.lock(); parent; parent = parent->parent_.lock()) {
+        parent->subtreeSize_ += delta;
+    }
+}
 
-    return BoxMetric{
-        .bounds   = Rect(finalPos, finalSize),
-        .rotation = 0.0f
+void Node::adjust_holders_(std::size_t id, std::ptrdiff_t delta) {
+    auto adjust = [id, delta](Node &node) {
+        if (id >= node.holders_.size()) {
+            node.holders_.resize(id + 1);
+        }
+        node.holders_[id] += delta;
     };
+
+    adjust(*this);
+    for (auto parent = parent_.lock(); parent; parent = parent->parent_.lock()) {
+        adjust(*parent);
+    }
 }
 
-BoxMetric model_box(BoxModel model, BoxMetric parentMetric) noexcept {
-    BoxMetric metric = model_dim(model, parentMetric);
+void Node::adjust_holders_(const std::vector<std::size_t> &counts, std::ptrdiff_t sign) {
+    for (std::size_t id = 0; id < counts.size(); id++) {
+        if (counts[id] != 0) {
+            adjust_holders_(id, sign * static_cast<std::ptrdiff_t>(counts[id]));
+        }
+    }
+}
 
-    if (model.min.has_value()) {
-        BoxMetric minMetric = model_dim(*model.min, parentMetric);
-        metric.bounds       = unionsection(metric.bounds, minMetric.bounds);
+void Node::attach_children_(std::span<const std::shared_ptr<Node>> children, const std::source_location &where) {
+    if (children.empty()) {
+        return;
     }
 
-    if (model.min.has_value()) {
-        BoxMetric maxMetric = model_dim(*model.max, parentMetric);
-        metric.bounds       = intersection(metric.bounds, maxMetric.bounds);
+    // Ancestors are updated a single time for all children
+    std::size_t              size = 0;
+    std::vector<std::size_t> holders;
+
+    auto self = shared_from_this();
+    children_.reserve(children_.size() + children.size());
+    changedFrom_ = std::min(changedFrom_, children_.size());
+
+    for (const auto &child : children) {
+        bool dirty     = child->needs_layout_();
+        child->parent_ = self;
+        child->forget_inherited_();
+        child->damage_subtree_();
+        size += child->subtreeSize_;
+
+        if (children.size() > 1) {
+            if (holders.size() < child->holders_.size()) {
+                holders.resize(child->holders_.size());
+            }
+            for (std::size_t id = 0; id < child->holders_.size(); id++) {
+                holders[id] += child->holders_[id];
+            }
+        }
+
+        children_.push_back(child);
+        child->invalidate_model_(INVALIDATION_INSERT, where);
+
+        // Invalidating an already dirty child does not record it
+        if (dirty) {
+            mark_child_dirty_(child.get());
+        }
     }
 
-    return metric;
+    adjust_subtree_size_(static_cast<std::ptrdiff_t>(size));
+    adjust_holders_(children.size() > 1 ? holders : children.front()->holders_, 1);
 }
 
-BoxMetric transform_box(BoxMetric metric, Transformation t, BoxMetric parentMetric) noexcept {
-    int width, height;
-    SDL_GetWindowSize(appData.window, &width, &height);
+void Node::forget_inherited_(std::size_t id) const {
+    for (const auto &child : children_) {
+        if (id >= child->inherited_.size() || !child->inherited_[id].resolved) {
+            continue;
+        }
 
-    Vec2 screen  = Vec2(width, height);
-    Vec2 refPos  = t.originRefMode == REF_MODE_ABSOLUTE ? screen / 2.0f : parentMetric.bounds.center;
-    Vec2 refSize = t.originRefMode == REF_MODE_ABSOLUTE ? screen : parentMetric.bounds.extent;
+        child->inherited_[id] = Inherited{};
+        if (id >= child->contexts_.size() || !child->contexts_[id]) {
+            child->forget_inherited_(id);
+        }
+    }
+}
 
-    Vec2 origin = refPos + t.originPos + t.originAnchor * refSize + t.originFloating * metric.bounds.extent;
+void Node::forget_inherited_() const {
+    for (std::size_t id = 0; id < inherited_.size(); id++) {
+        if (!inherited_[id].resolved) {
+            continue;
+        }
 
-    Vec2 v = metric.bounds.center - origin;
-    v *= t.scale;
+        inherited_[id] = Inherited{};
+        if (id >= contexts_.size() || !contexts_[id]) {
+            forget_inherited_(id);
+        }
+    }
+}
 
-    metric.bounds.extent *= abs(t.scale);
+std::optional<std::uint64_t> Node::get_sync_version_() const noexcept {
+    std::uint64_t version = std::max(get_params_version(), contextsVersion_);
+    for (const auto &context : contexts_) {
+        if (!context) {
+            continue;
+        }
 
-    v = rotate(v, t.rotate);
-    metric.rotation += t.rotate;
+        std::uint64_t contextVersion = context->get_version();
+        if (contextVersion == 0) {
+            return std::nullopt;
+        }
+        version = std::max(version, contextVersion);
+    }
+    return version;
+}
 
-    metric.bounds.center = origin + v + t.offset;
+void Node::reserve_clones_(std::size_t count) {
+    clones_.erase(std::remove_if(clones_.begin(), clones_.end(), [](const std::weak_ptr<Node> &clone) { return clone.expired(); }), clones_.end());
+    clones_.reserve(clones_.size() + count);
 
-    return metric;
+    for (const auto &child : children_) {
+        child->reserve_clones_(count);
+    }
 }
 
-BoxMetric transform_box(BoxMetric metric, const TStack &tStack, BoxMetric parentMetric) noexcept {
-    for (const Transformation &t : tStack) {
-        metric = transform_box(metric, t, parentMetric);
+bool Node::store_t_metric_(BoxMetric metric) const {
+    if (metric != tMetric_) {
+        bool damage = appData.damage.enabled;
+        if (damage) {
+            appData.damage.add(get_world_bounds());
+        }
+
+        tMetric_      = metric;
+        localToWorld_ = local_to_world(metric);
+        worldToLocal_ = world_to_local(metric);
+
+        if (damage) {
+            appData.damage.add(get_world_bounds());
+        }
+        appData.moves.add(this);
+    }
+
+    BoxMetric reference = tMetric_;
+    if (lazyTransform_) {
+        reference = lazy_reference(mMetric_, tMetric_);
+        lazy_     = mm(localToWorld_, Mat3(1.0f, 0.0f, -reference.bounds.center.x, 0.0f, 1.0f, -reference.bounds.center.y, 0.0f, 0.0f, 1.0f));
+    } else {
+        lazy_ = IDENTITY_TRANSFORM;
     }
 
-    return metric;
+    bool changed = reference != childRef_;
+    childRef_    = reference;
+    return changed;
 }
 
-Context::Context() {
+void Node::flush_layout_(const LayoutContext &context, BoxMetric parentMetric, bool force, const Node *origin) const {
+    GLARENS_ZONE_SUBJECT("layout", this);
+
+    bool changed = false;
+
+    // Recomputes forced by this node are attributed to it rather than to the ancestor that forced it
+    bool dirty = modelDirty_ || transformDirty_;
+    if ((force || dirty) && appData.invalidations.enabled.load(std::memory_order_relaxed)) {
+        count_recompute_(dirty ? nullptr : origin);
+    }
+    origin = dirty ? this : origin;
+
+    // Visited nodes lie on the path to every change, so their retained geometry is conservatively stale
+    renderDirty_ = true;
+
+    if (force || modelDirty_) {
+        mMetric_ = model_box(model_.get(), parentMetric, context);
+    }
+
+    if (force || modelDirty_ || transformDirty_) {
+        // The composition only depends on the stack, the reference metric and the modeled extent
+        if (composedStale_ || composedRef_ != parentMetric || composedSize_ != mMetric_.bounds.extent || composedView_ != context.viewport) {
+            composed_      = compose_transform(tStack_.get(), mMetric_.bounds.extent, parentMetric, context);
+            composedRef_   = parentMetric;
+            composedSize_  = mMetric_.bounds.extent;
+            composedView_  = context.viewport;
+            composedStale_ = false;
+        }
+
+        changed         = store_t_metric_(apply_transform(mMetric_, composed_));
+        modelDirty_     = false;
+        transformDirty_ = false;
+    }
+
+    // Descendants are only affected when the reference metric has changed
+    if (!changed && !childrenDirty_) {
+        return;
+    }
+
+    // Children re-modeled here stop propagating at this node, which is still marked
+    childrenDirty_ = true;
+    on_model(context);
+
+    childrenDirty_ = false;
+    changedFrom_   = SIZE_MAX;
+    contentDirty_  = true;
+
+    // Subtree flushes and arena commits may leave stale or repeated records
+    if (!changed) {
+        std::sort(dirtyChildren_.begin(), dirtyChildren_.end());
+        dirtyChildren_.erase(std::unique(dirtyChildren_.begin(), dirtyChildren_.end()), dirtyChildren_.end());
+        std::erase_if(dirtyChildren_, [](const Node *child) { return !child->needs_layout_(); });
+    }
+
+    // Sibling subtrees only depend on this metric, so large ones can be laid out concurrently
+    ThreadPool       *pool = appData.layoutPool.get();
+    ThreadPool::Group group;
+    bool              parallel = pool && (changed ? children_.size() : dirtyChildren_.size()) > 1;
+    if (parallel) {
+        parallelLayouts_++;
+    }
+
+    auto visit = [&](const Node *child) {
+        if (parallel && child->subtreeSize_ >= appData.layoutThreshold) {
+            pool->submit(group, [&context, metric = childRef_, child, changed, origin] { child->flush_layout_(context, metric, changed, origin); });
+        } else {
+            child->flush_layout_(context, childRef_, changed, origin);
+        }
+    };
+
+    // A changed reference metric affects every child, otherwise only the recorded ones need a visit
+    if (changed) {
+        for (const auto &child : children_) {
+            visit(child.get());
+        }
+    } else {
+        for (const Node *child : dirtyChildren_) {
+            visit(child);
+        }
+    }
+
+    if (parallel) {
+        pool->wait(group);
+        parallelLayouts_--;
+    }
+    dirtyChildren_.clear();
 }
 
-void Node::update_m_metric_() const {
-    BoxMetric parentMetric = BoxMetric::screen_metric();
+void Node::flush_layout() const {
+    if (!needs_layout_()) {
+        return;
+    }
+
+    LayoutContext context      = LayoutContext::capture();
+    BoxMetric     parentMetric = BoxMetric::screen_metric(context);
     if (auto parent = parent_.lock()) {
-        parentMetric = parent->tMetric_;
+        parentMetric = parent->childRef_;
     }
 
-    mMetric_ = model_box(model_.get(), parentMetric);
-    update_t_metric_();
+    flush_layout_(context, parentMetric, false, nullptr);
 }
 
-void Node::update_t_metric_() const {
-    BoxMetric parentMetric = BoxMetric::screen_metric();
-    if (auto parent = parent_.lock()) {
-        parentMetric = parent->tMetric_;
+void Node::place_child_(const Node &child) const {
+    Mat3 world = lazyTransform_ ? mm(world_, lazy_) : world_;
+    if (world.m == child.world_.m) {
+        return;
+    }
+
+    bool damage = appData.damage.enabled;
+    if (damage) {
+        appData.damage.add(child.get_world_bounds());
+    }
+
+    child.world_       = world;
+    child.worldInv_    = inv(world);
+    child.worldAngle_  = atan2(world.m[3], world.m[0]);
+    child.renderDirty_ = true;
+
+    if (damage) {
+        appData.damage.add(child.get_world_bounds());
     }
+    appData.moves.add(&child);
+}
 
-    tMetric_ = transform_box(mMetric_, tStack_.get(), parentMetric);
+void Node::place_descendants() const {
     for (const auto &child : children_) {
-        child->update_m_metric_();
+        place_child_(*child);
+        child->place_descendants();
+    }
+}
+
+void Node::damage_subtree_() const {
+    if (!appData.damage.enabled) {
+        return;
+    }
+
+    appData.damage.add(get_world_bounds());
+    for (const auto &child : children_) {
+        child->damage_subtree_();
+    }
+}
+
+void Node::invalidate_render() const {
+    appData.damage.add(get_world_bounds());
+    renderDirty_  = true;
+    contentDirty_ = true;
+    for (auto parent = parent_.lock(); parent; parent = parent->parent_.lock()) {
+        parent->renderDirty_  = true;
+        parent->contentDirty_ = true;
     }
 }
 
@@ -123,18 +513,220 @@ Node::Node() {
     refresh_metric();
 }
 
+Rect Node::get_world_bounds() const noexcept {
+    Vec2 half = abs(tMetric_.bounds.extent) * 0.5f;
+    Vec2 lo   = Vec2(INFINITY, INFINITY);
+    Vec2 hi   = Vec2(-INFINITY, -INFINITY);
+
+    // Corners of the oriented box, mapped through the lazy transformation of ancestors
+    for (Vec2 corner : {Vec2(-half.x, -half.y), Vec2(half.x, -half.y), Vec2(half.x, half.y), Vec2(-half.x, half.y)}) {
+        Vec2 world = Vec2(mr(world_, mr(localToWorld_, Vec3(corner, 1.0f))));
+        lo         = min(lo, world);
+        hi         = max(hi, world);
+    }
+
+    return Rect((lo + hi) * 0.5f, hi - lo);
+}
+
+void Node::draw_(bool visible) const {
+    if (visible) {
+        pre_render();
+    }
+
+    if (enableChildrenRender) {
+        for (const auto &child : children_) {
+            place_child_(*child);
+            child->render();
+        }
+    }
+
+    if (visible) {
+        post_render();
+    }
+}
+
+bool Node::render_layer_() const {
+    SDL_Renderer *renderer = appData.renderer;
+    Vec2          extent   = abs(tMetric_.bounds.extent);
+    auto          width    = static_cast<int>(std::ceil(extent.x));
+    auto          height   = static_cast<int>(std::ceil(extent.y));
+    if (!renderer) {
+        return false;
+    }
+
+    // Nothing to composite
+    if (width <= 0 || height <= 0) {
+        return true;
+    }
+
+    if (!layerTexture_) {
+        layerTexture_ = std::make_shared<LayerTexture>();
+    }
+
+    bool fresh = appData.layers.acquire(renderer, *layerTexture_, width, height);
+    if (!layerTexture_->texture) {
+        return false;
+    }
+
+    // Pending geometry belongs below the layer
+    appData.batch.flush(renderer);
+
+    if (fresh || contentDirty_) {
+        SDL_Texture *target  = SDL_GetRenderTarget(renderer);
+        SDL_Rect     clip    = {};
+        bool         clipped = SDL_RenderClipEnabled(renderer) && SDL_GetRenderClipRect(renderer, &clip);
+
+        std::uint8_t r, g, b, a;
+        SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+
+        GLARENS_ZONE_SUBJECT("layer", this);
+
+        SDL_SetRenderTarget(renderer, layerTexture_->texture);
+        SDL_SetRenderClipRect(renderer, nullptr);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+        SDL_SetRenderDrawColor(renderer, r, g, b, a);
+
+        // Draw in the unrotated frame of the bounds, with the texture as the visible region
+        CullPass pass    = cullPass;
+        cullPass.culling = true;
+        cullPass.region  = Rect::from_xywh(Vec2(0.0f, 0.0f), Vec2(width, height));
+
+        Mat3  world      = world_;
+        Mat3  worldInv   = worldInv_;
+        float worldAngle = worldAngle_;
+        world_           = mm(Mat3(1.0f, 0.0f, width * 0.5f, 0.0f, 1.0f, height * 0.5f, 0.0f, 0.0f, 1.0f), worldToLocal_);
+        worldInv_        = inv(world_);
+        worldAngle_      = -tMetric_.rotation;
+
+        // Texture coordinates are not render coordinates
+        bool damage            = appData.damage.enabled;
+        appData.damage.enabled = false;
+
+        layerTexture_->pinned = true;
+        draw_(true);
+        appData.batch.flush(renderer);
+        layerTexture_->pinned = false;
+
+        world_      = world;
+        worldInv_   = worldInv;
+        worldAngle_ = worldAngle;
+        cullPass    = pass;
+
+        // Descendants were placed in the texture frame, move them back for picking
+        place_descendants();
+        appData.damage.enabled = damage;
+
+        SDL_SetRenderTarget(renderer, target);
+        SDL_SetRenderClipRect(renderer, clipped ? &clip : nullptr);
+
+        contentDirty_ = false;
+    }
+
+    BoxMetric metric = get_world_metric();
+    SDL_FRect rect   = to_sdl_rect(Rect(metric.bounds.center, extent));
+    SDL_RenderTextureRotated(renderer, layerTexture_->texture, nullptr, &rect, metric.rotation * 180.0 / SDL_PI_D, nullptr, SDL_FLIP_NONE);
+    return true;
+}
+
+void Node::render() const {
+    if (!enableRender) {
+        return;
+    }
+
+    GLARENS_ZONE_SUBJECT("render", this);
+    CullScope scope(*this);
+
+    bool visible = CullScope::visible(*this);
+    if (!visible && (childrenInside || layer)) {
+        return;
+    }
+
+    if (layer && render_layer_()) {
+        renderDirty_ = false;
+        return;
+    }
+
+    bool retained = retainRender && recording_ && !renderDirty_ && recordRegion_.center == cullPass.region.center && recordRegion_.extent == cullPass.region.extent;
+    if (retained) {
+        appData.batch.replay(*recording_);
+        return;
+    }
+
+    RenderBatch::Mark mark = appData.batch.get_mark();
+
+    draw_(visible);
+
+    if (retainRender) {
+        if (!recording_) {
+            recording_ = std::make_shared<RenderRecording>();
+        }
+
+        // Geometry flushed mid-way cannot be replayed, so stay stale and record again next time
+        if (!appData.batch.record(mark, *recording_)) {
+            recording_.reset();
+            return;
+        }
+        recordRegion_ = cullPass.region;
+    } else {
+        recording_.reset();
+    }
+
+    renderDirty_ = false;
+}
+
 void Node::debug() const {
-    std::size_t this_ptr = std::size_t(this);
-    float       hue      = ((this_ptr >> 16) ^ (this_ptr) * 12987391ULL) % 36 / 36.0f;
-    Color       color    = Color::from_hsl(hue, 0.5f, 0.9f);
+    GLARENS_ZONE_SUBJECT("debug", this);
+    CullScope scope(*this);
+
+    bool visible = CullScope::visible(*this);
+    if (!visible && childrenInside) {
+        return;
+    }
+
+    if (visible) {
+        std::size_t this_ptr = std::size_t(this);
+        float       hue      = ((this_ptr >> 16) ^ (this_ptr) * 12987391ULL) % 36 / 36.0f;
+        Color       color    = Color::from_hsl(hue, 0.5f, 0.9f);
 
-    SDL_FRect rect = to_sdl_rect(tMetric_.bounds);
-    SDL_SetRenderDrawColor(appData.renderer, color.r, color.g, color.b, 255);
-    SDL_RenderRect(appData.renderer, &rect);
-    SDL_SetRenderDrawColor(appData.renderer, color.r, color.g, color.b, 63);
-    SDL_RenderFillRect(appData.renderer, &rect);
+        // Heat map from blue to red, relative to the costliest tracked node on a log scale
+        if (appData.invalidations.enabled.load(std::memory_order_relaxed)) {
+            InvalidationStats stats = get_invalidation_stats();
+            std::uint64_t     peak  = appData.invalidations.peak.load(std::memory_order_relaxed);
+            float             heat  = peak == 0 ? 0.0f : std::log2(1.0f + stats.recomputes + stats.touched) / std::log2(1.0f + peak);
+            color                   = Color::from_hsl((1.0f - heat) * (2.0f / 3.0f), 0.9f, 0.5f + 0.2f * (1.0f - heat));
+        }
+
+        BoxMetric metric = get_world_metric();
+        Color     fill   = color;
+        fill.a           = 63;
+        appData.batch.fill_rect(metric, fill);
+        appData.batch.stroke_rect(metric, color);
+    }
 
     for (const auto &child : children_) {
+        place_child_(*child);
         child->debug();
     }
 }
+
+std::vector<std::shared_ptr<Node>> instantiate(const std::shared_ptr<Node> &proto, std::size_t count, const std::shared_ptr<Node> &parent, const std::source_location &where) {
+    std::vector<std::shared_ptr<Node>> instances;
+    instances.reserve(count);
+    if (count == 0) {
+        return instances;
+    }
+
+    proto->reserve_clones_(count);
+    for (std::size_t i = 0; i < count; i++) {
+        instances.push_back(proto->clone());
+    }
+
+    if (!parent) {
+        return instances;
+    }
+
+    parent->attach_children_(instances, where);
+
+    return instances;
+}
@@ -0,0 +1,210 @@
+// Glarens - GUI Framework.
+//
+// Scoped-zone frame profiler implementation.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/profiler.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if GLARENS_PROFILER
+
+static constexpr std::size_t RING_SIZE   = 1 << 16; /// Zones kept per thread, a power of two
+static constexpr std::size_t FRAME_COUNT = 240;     /// Frame times kept for the histogram
+
+/// Written only by its thread; readers may see torn events while it records
+struct ProfileRing {
+    std::vector<ProfileEvent>  events = std::vector<ProfileEvent>(RING_SIZE);
+    std::atomic<std::uint64_t> written{0};
+    std::atomic<std::uint64_t> cleared{0}; /// Events written before it were dropped by glarens_clear_profile()
+    std::uint32_t              thread = 0;
+};
+
+struct ProfileState {
+    std::mutex                                mutex; /// Guards the ring lists and frame times, zones only take it once per thread
+    std::vector<std::shared_ptr<ProfileRing>> rings;
+    std::vector<ProfileRing *>                spares; /// Rings of exited threads, taken over by new threads
+
+    std::array<float, FRAME_COUNT> frames     = {};
+    std::size_t                    frameCount = 0;
+    std::uint64_t                  lastFrame  = 0;
+
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+static ProfileState &profile() {
+    static ProfileState instance;
+    return instance;
+}
+
+/// Ring lent to a thread for its lifetime, so rebuilt thread pools reuse the rings of the previous workers
+struct RingLease {
+    ProfileRing *ring = nullptr;
+
+    RingLease() {
+        ProfileState   &p = profile();
+        std::lock_guard lock(p.mutex);
+        if (!p.spares.empty()) {
+            ring = p.spares.back();
+            p.spares.pop_back();
+            return;
+        }
+
+        auto owned    = std::make_shared<ProfileRing>();
+        owned->thread = static_cast<std::uint32_t>(p.rings.size());
+        ring          = owned.get();
+        p.rings.push_back(std::move(owned));
+    }
+
+    ~RingLease() {
+        ProfileState   &p = profile();
+        std::lock_guard lock(p.mutex);
+        p.spares.push_back(ring);
+    }
+
+    RingLease(const RingLease &)            = delete;
+    RingLease &operator=(const RingLease &) = delete;
+};
+
+/// Ring of the calling thread, leased on first use
+/// Note: the events of an exited thread stay under its thread identifier until the next owner overwrites them
+static ProfileRing &local_ring() {
+    thread_local RingLease lease;
+    return *lease.ring;
+}
+
+std::uint64_t ProfileZone::now_() noexcept {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - profile().epoch).count());
+}
+
+void ProfileZone::record_(const ProfileEvent &event) noexcept {
+    ProfileRing  &ring    = local_ring();
+    std::uint64_t written = ring.written.load(std::memory_order_relaxed);
+    ring.events[written & (RING_SIZE - 1)] = event;
+    ring.written.store(written + 1, std::memory_order_release);
+}
+
+void glarens_set_profiling(bool enable, std::uint32_t maxDepth) {
+    ProfileZone::maxDepth_.store(maxDepth, std::memory_order_relaxed);
+    ProfileZone::enabled_.store(enable, std::memory_order_relaxed);
+}
+
+void glarens_mark_frame() {
+    if (!ProfileZone::enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    ProfileState &p   = profile();
+    std::uint64_t now = ProfileZone::now_();
+
+    std::lock_guard lock(p.mutex);
+    if (p.lastFrame != 0) {
+        p.frames[p.frameCount++ % FRAME_COUNT] = static_cast<float>(now - p.lastFrame) / 1.0e6f;
+    }
+    p.lastFrame = now;
+}
+
+bool glarens_write_trace(const char *path) {
+    std::FILE *file = std::fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+
+    ProfileState &p = profile();
+
+    std::lock_guard lock(p.mutex);
+    std::fputs("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [", file);
+
+    bool first = true;
+    for (const auto &ring : p.rings) {
+        std::uint64_t written = ring->written.load(std::memory_order_acquire);
+        std::uint64_t begin   = std::max(ring->cleared.load(std::memory_order_relaxed), written - std::min<std::uint64_t>(written, RING_SIZE));
+
+        for (std::uint64_t i = begin; i < written; i++) {
+            const ProfileEvent &event = ring->events[i & (RING_SIZE - 1)];
+            if (!event.name) {
+                continue;
+            }
+
+            // Complete events, timestamps in microseconds
+            std::fprintf(
+                file, "%s\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f, \"dur\": %.3f, \"args\": {\"subject\": \"%p\", \"depth\": %u}}",
+                first ? "" : ",", event.name, ring->thread, event.begin / 1.0e3, (event.end - event.begin) / 1.0e3, event.subject, event.depth
+            );
+            first = false;
+        }
+    }
+
+    std::fputs("\n]}\n", file);
+    return std::fclose(file) == 0;
+}
+
+FrameHistogram glarens_get_frame_histogram() {
+    ProfileState &p = profile();
+
+    std::vector<float> times;
+    {
+        std::lock_guard lock(p.mutex);
+        times.assign(p.frames.begin(), p.frames.begin() + std::min(p.frameCount, FRAME_COUNT));
+    }
+
+    FrameHistogram histogram;
+    histogram.frames = times.size();
+    if (times.empty()) {
+        return histogram;
+    }
+
+    float sum = 0.0f;
+    for (float ms : times) {
+        auto bucket = static_cast<std::size_t>(ms / FrameHistogram::BUCKET_MS);
+        histogram.counts[std::min(bucket, FrameHistogram::BUCKETS - 1)]++;
+        sum += ms;
+    }
+
+    std::sort(times.begin(), times.end());
+    histogram.minMs  = times.front();
+    histogram.maxMs  = times.back();
+    histogram.meanMs = sum / static_cast<float>(times.size());
+    histogram.p99Ms  = times[(times.size() - 1) * 99 / 100];
+    return histogram;
+}
+
+void glarens_clear_profile() {
+    ProfileState &p = profile();
+
+    std::lock_guard lock(p.mutex);
+    for (const auto &ring : p.rings) {
+        ring->cleared.store(ring->written.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+    p.frameCount = 0;
+    p.lastFrame  = 0;
+}
+
+#else
+
+void glarens_set_profiling(bool, std::uint32_t) {}
+
+void glarens_mark_frame() {}
+
+bool glarens_write_trace(const char *) {
+    return false;
+}
+
+FrameHistogram glarens_get_frame_histogram() {
+    return FrameHistogram{};
+}
+
+void glarens_clear_profile() {}
+
+#endif
@@ -0,0 +1,119 @@
+// Glarens - GUI Framework.
+//
+// Batched geometry rendering implementation.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/render-batch.hpp"
+#include "glarens/math.hpp"
+#include "glarens/node.hpp"
+#include <SDL3/SDL_render.h>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+void RenderBatch::push_quad_(Vec2 a, Vec2 b, Vec2 c, Vec2 d, Color color) {
+    SDL_FColor fcolor{Color::to_norm(color.r), Color::to_norm(color.g), Color::to_norm(color.b), Color::to_norm(color.a)};
+
+    int base = static_cast<int>(vertices_.size());
+    for (Vec2 p : {a, b, c, d}) {
+        vertices_.push_back(SDL_Vertex{
+            .position  = SDL_FPoint{p.x, p.y},
+            .color     = fcolor,
+            .tex_coord = SDL_FPoint{0.0f, 0.0f}
+        });
+    }
+
+    for (int i : {0, 1, 2, 0, 2, 3}) {
+        indices_.push_back(base + i);
+    }
+}
+
+void RenderBatch::fill_rect(BoxMetric metric, Color color) {
+    Vec2  half = metric.bounds.extent * 0.5f;
+    Vec2  c    = metric.bounds.center;
+    float r    = metric.rotation;
+
+    push_quad_(
+        c + rotate(Vec2(-half.x, -half.y), r),
+        c + rotate(Vec2(half.x, -half.y), r),
+        c + rotate(Vec2(half.x, half.y), r),
+        c + rotate(Vec2(-half.x, half.y), r),
+        color
+    );
+}
+
+void RenderBatch::stroke_rect(BoxMetric metric, Color color, float thickness) {
+    Vec2  half  = abs(metric.bounds.extent) * 0.5f;
+    Vec2  inner = max(half - thickness, 0.0f);
+    Vec2  c     = metric.bounds.center;
+    float r     = metric.rotation;
+
+    auto corner = [&](float x, float y) { return c + rotate(Vec2(x, y), r); };
+
+    // Top and bottom span the full width, the sides fill in between
+    push_quad_(corner(-half.x, -half.y), corner(half.x, -half.y), corner(half.x, -inner.y), corner(-half.x, -inner.y), color);
+    push_quad_(corner(-half.x, inner.y), corner(half.x, inner.y), corner(half.x, half.y), corner(-half.x, half.y), color);
+    push_quad_(corner(-half.x, -inner.y), corner(-inner.x, -inner.y), corner(-inner.x, inner.y), corner(-half.x, inner.y), color);
+    push_quad_(corner(inner.x, -inner.y), corner(half.x, -inner.y), corner(half.x, inner.y), corner(inner.x, inner.y), color);
+}
+
+void RenderBatch::line(Vec2 from, Vec2 to, Color color, float thickness) {
+    Vec2  d      = to - from;
+    float length = std::sqrt(d.x * d.x + d.y * d.y);
+    if (length <= 0.0f) {
+        return;
+    }
+
+    Vec2 n = Vec2(-d.y, d.x) * (thickness * 0.5f / length);
+    push_quad_(from + n, to + n, to - n, from - n, color);
+}
+
+void RenderBatch::fill_quad(Vec2 a, Vec2 b, Vec2 c, Vec2 d, Color color) {
+    push_quad_(a, b, c, d, color);
+}
+
+bool RenderBatch::record(Mark since, RenderRecording &recording) const {
+    if (since.generation != generation_) {
+        return false;
+    }
+
+    recording.vertices.assign(vertices_.begin() + since.vertices, vertices_.end());
+    recording.indices.resize(indices_.size() - since.indices);
+    for (std::size_t i = 0; i < recording.indices.size(); i++) {
+        recording.indices[i] = indices_[since.indices + i] - static_cast<int>(since.vertices);
+    }
+    return true;
+}
+
+void RenderBatch::replay(const RenderRecording &recording) {
+    int base = static_cast<int>(vertices_.size());
+    vertices_.insert(vertices_.end(), recording.vertices.begin(), recording.vertices.end());
+
+    std::size_t first = indices_.size();
+    indices_.resize(first + recording.indices.size());
+    for (std::size_t i = 0; i < recording.indices.size(); i++) {
+        indices_[first + i] = recording.indices[i] + base;
+    }
+}
+
+void RenderBatch::flush(SDL_Renderer *renderer) {
+    if (indices_.empty()) {
+        return;
+    }
+
+    if (renderer) {
+        SDL_RenderGeometry(renderer, nullptr, vertices_.data(), static_cast<int>(vertices_.size()), indices_.data(), static_cast<int>(indices_.size()));
+        submits_++;
+    }
+
+    clear();
+}
+
+void RenderBatch::clear() noexcept {
+    vertices_.clear();
+    indices_.clear();
+    generation_++;
+}
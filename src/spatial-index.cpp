@@ -0,0 +1,277 @@
+// Glarens - GUI Framework.
+//
+// Spatial index implementation.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/spatial-index.hpp"
+#include "glarens/math.hpp"
+#include "glarens/node.hpp"
+#include "internal/app-data.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+static std::uint64_t cell_key(std::int32_t x, std::int32_t y) noexcept {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+}
+
+static void sorted_insert(std::vector<std::uint32_t> &list, std::uint32_t index) {
+    list.insert(std::lower_bound(list.begin(), list.end(), index), index);
+}
+
+static void sorted_erase(std::vector<std::uint32_t> &list, std::uint32_t index) {
+    auto it = std::lower_bound(list.begin(), list.end(), index);
+    if (it != list.end() && *it == index) {
+        list.erase(it);
+    }
+}
+
+void SpatialIndex::bound_(Entry &entry) const {
+    Rect bounds = entry.node->get_world_bounds();
+    entry.min   = bounds.center - bounds.extent * 0.5f;
+    entry.max   = bounds.center + bounds.extent * 0.5f;
+
+    Vec2 first = floor(entry.min / cellSize_);
+    Vec2 last  = floor(entry.max / cellSize_);
+    Vec2 span  = last - first + 1.0f;
+
+    // Also catches bounds too far away to be addressed by cell coordinates
+    entry.large = !(span.x * span.y <= static_cast<float>(LARGE_CELLS));
+    if (entry.large) {
+        return;
+    }
+
+    entry.cells[0] = static_cast<std::int32_t>(first.x);
+    entry.cells[1] = static_cast<std::int32_t>(first.y);
+    entry.cells[2] = static_cast<std::int32_t>(last.x);
+    entry.cells[3] = static_cast<std::int32_t>(last.y);
+}
+
+void SpatialIndex::insert_(std::uint32_t index) {
+    const Entry &entry = entries_[index];
+    if (entry.large) {
+        sorted_insert(large_, index);
+        return;
+    }
+
+    for (std::int32_t y = entry.cells[1]; y <= entry.cells[3]; y++) {
+        for (std::int32_t x = entry.cells[0]; x <= entry.cells[2]; x++) {
+            sorted_insert(cells_[cell_key(x, y)], index);
+        }
+    }
+}
+
+void SpatialIndex::erase_(std::uint32_t index) {
+    const Entry &entry = entries_[index];
+    if (entry.large) {
+        sorted_erase(large_, index);
+        return;
+    }
+
+    for (std::int32_t y = entry.cells[1]; y <= entry.cells[3]; y++) {
+        for (std::int32_t x = entry.cells[0]; x <= entry.cells[2]; x++) {
+            auto it = cells_.find(cell_key(x, y));
+            if (it == cells_.end()) {
+                continue;
+            }
+
+            sorted_erase(it->second, index);
+            if (it->second.empty()) {
+                cells_.erase(it);
+            }
+        }
+    }
+}
+
+template <typename Fn>
+void SpatialIndex::candidates_(Vec2 min, Vec2 max, Fn &&fn) const {
+    Vec2 first = floor(min / cellSize_);
+    Vec2 last  = floor(max / cellSize_);
+    Vec2 span  = last - first + 1.0f;
+
+    // Scanning every entry is cheaper than visiting more cells than there are entries
+    std::vector<std::uint32_t> found;
+    if (!(span.x * span.y <= static_cast<float>(entries_.size()))) {
+        found.resize(entries_.size());
+        for (std::uint32_t index = 0; index < entries_.size(); index++) {
+            found[index] = static_cast<std::uint32_t>(entries_.size()) - 1 - index;
+        }
+    } else {
+        found = large_;
+        for (auto y = static_cast<std::int32_t>(first.y); y <= static_cast<std::int32_t>(last.y); y++) {
+            for (auto x = static_cast<std::int32_t>(first.x); x <= static_cast<std::int32_t>(last.x); x++) {
+                auto it = cells_.find(cell_key(x, y));
+                if (it != cells_.end()) {
+                    found.insert(found.end(), it->second.begin(), it->second.end());
+                }
+            }
+        }
+
+        // Later entries are rendered on top
+        std::sort(found.begin(), found.end(), [](std::uint32_t a, std::uint32_t b) { return a > b; });
+        found.erase(std::unique(found.begin(), found.end()), found.end());
+    }
+
+    for (std::uint32_t index : found) {
+        const Entry &entry = entries_[index];
+        if (entry.max.x < min.x || entry.min.x > max.x || entry.max.y < min.y || entry.min.y > max.y) {
+            continue;
+        }
+
+        if (!fn(*entry.node)) {
+            return;
+        }
+    }
+}
+
+SpatialIndex::SpatialIndex(SpatialIndex &&index) noexcept
+    : cellSize_(index.cellSize_), entries_(std::move(index.entries_)), cells_(std::move(index.cells_)), large_(std::move(index.large_)), lookup_(std::move(index.lookup_)), reader_(std::exchange(index.reader_, NO_READER)), checks_(index.checks_) {}
+
+SpatialIndex &SpatialIndex::operator=(SpatialIndex &&index) noexcept {
+    if (this != &index) {
+        clear();
+        cellSize_ = index.cellSize_;
+        entries_  = std::move(index.entries_);
+        cells_    = std::move(index.cells_);
+        large_    = std::move(index.large_);
+        lookup_   = std::move(index.lookup_);
+        reader_   = std::exchange(index.reader_, NO_READER);
+        checks_   = index.checks_;
+    }
+    return *this;
+}
+
+SpatialIndex::~SpatialIndex() {
+    clear();
+}
+
+void SpatialIndex::build(const std::shared_ptr<Node> &root) {
+    clear();
+    if (!root) {
+        return;
+    }
+
+    // Moves before this point are already in the bounds read below
+    reader_ = appData.moves.open();
+
+    // Same traversal as render(), children pushed in reverse to keep sibling order
+    std::vector<const Node *> stack;
+    stack.push_back(root.get());
+
+    while (!stack.empty()) {
+        const Node *node = stack.back();
+        stack.pop_back();
+
+        if (!node->enableRender) {
+            continue;
+        }
+
+        Entry entry{};
+        entry.node = node;
+        bound_(entry);
+        entries_.push_back(entry);
+        lookup_.emplace(node, static_cast<std::uint32_t>(entries_.size() - 1));
+        insert_(static_cast<std::uint32_t>(entries_.size() - 1));
+
+        if (node->enableChildrenRender) {
+            for (auto it = node->children_.rbegin(); it != node->children_.rend(); it++) {
+                stack.push_back(it->get());
+            }
+        }
+    }
+}
+
+std::size_t SpatialIndex::refit() {
+    checks_ = 0;
+    if (reader_ == NO_READER) {
+        return 0;
+    }
+
+    // Nodes may have moved several times, or be indexed elsewhere
+    std::vector<const Node *> nodes = appData.moves.read(reader_);
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+    std::size_t moved = 0;
+    for (const Node *node : nodes) {
+        auto it = lookup_.find(node);
+        if (it == lookup_.end()) {
+            continue;
+        }
+
+        std::uint32_t index = it->second;
+        Entry         entry = entries_[index];
+        bound_(entry);
+        checks_++;
+
+        const Entry &old = entries_[index];
+        if (entry.min == old.min && entry.max == old.max) {
+            continue;
+        }
+
+        bool rebucket = entry.large != old.large || !std::equal(entry.cells, entry.cells + 4, old.cells);
+        if (rebucket) {
+            erase_(index);
+        }
+        entries_[index] = entry;
+        if (rebucket) {
+            insert_(index);
+        }
+        moved++;
+    }
+
+    return moved;
+}
+
+const Node *SpatialIndex::pick(Vec2 position) const {
+    const Node *picked = nullptr;
+    candidates_(position, position, [&](const Node &node) {
+        if (node.hit_test(position)) {
+            picked = &node;
+            return false;
+        }
+        return true;
+    });
+    return picked;
+}
+
+std::vector<const Node *> SpatialIndex::pick_all(Vec2 position) const {
+    std::vector<const Node *> picked;
+    candidates_(position, position, [&](const Node &node) {
+        if (node.hit_test(position)) {
+            picked.push_back(&node);
+        }
+        return true;
+    });
+    return picked;
+}
+
+std::vector<const Node *> SpatialIndex::query(Rect rect) const {
+    Vec2 half = abs(rect.extent) * 0.5f;
+
+    std::vector<const Node *> found;
+    candidates_(rect.center - half, rect.center + half, [&](const Node &node) {
+        found.push_back(&node);
+        return true;
+    });
+    return found;
+}
+
+void SpatialIndex::clear() noexcept {
+    entries_.clear();
+    cells_.clear();
+    large_.clear();
+    lookup_.clear();
+    checks_ = 0;
+
+    if (reader_ != NO_READER) {
+        appData.moves.close(reader_);
+        reader_ = NO_READER;
+    }
+}
@@ -0,0 +1,133 @@
+// Glarens - GUI Framework.
+//
+// Work-stealing thread pool implementation.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "internal/thread-pool.hpp"
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+static constexpr std::size_t NOT_A_WORKER = std::numeric_limits<std::size_t>::max();
+
+static thread_local const ThreadPool *currentPool   = nullptr;
+static thread_local std::size_t       currentWorker = NOT_A_WORKER;
+
+ThreadPool::ThreadPool(std::size_t threadCount) {
+    for (std::size_t i = 0; i < threadCount; i++) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+
+    for (std::size_t i = 0; i < threadCount; i++) {
+        threads_.emplace_back([this, i] { work_(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(sleepMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+
+    for (auto &thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(Group &group, std::function<void()> fn) {
+    // Workers keep their own tasks local, external threads spread them round-robin
+    std::size_t target = currentPool == this ? currentWorker : next_++ % workers_.size();
+
+    group.pending_++;
+    {
+        std::lock_guard lock(workers_[target]->mutex);
+        workers_[target]->tasks.push_back(Task{std::move(fn), &group});
+    }
+
+    {
+        std::lock_guard lock(sleepMutex_);
+        queued_++;
+    }
+    wake_.notify_one();
+}
+
+void ThreadPool::wait(Group &group) {
+    std::size_t self = currentPool == this ? currentWorker : NOT_A_WORKER;
+
+    while (group.pending_ > 0) {
+        if (!try_run_one_(self)) {
+            std::this_thread::yield();
+        }
+    }
+
+    if (group.error_) {
+        std::rethrow_exception(std::exchange(group.error_, nullptr));
+    }
+}
+
+bool ThreadPool::try_run_one_(std::size_t self) {
+    Task task;
+    bool found = false;
+
+    if (self != NOT_A_WORKER) {
+        std::lock_guard lock(workers_[self]->mutex);
+        if (!workers_[self]->tasks.empty()) {
+            task = std::move(workers_[self]->tasks.back());
+            workers_[self]->tasks.pop_back();
+            found = true;
+        }
+    }
+
+    for (std::size_t i = 0; !found && i < workers_.size(); i++) {
+        std::size_t victim = self == NOT_A_WORKER ? i : (self + i + 1) % workers_.size();
+
+        std::lock_guard lock(workers_[victim]->mutex);
+        if (!workers_[victim]->tasks.empty()) {
+            task = std::move(workers_[victim]->tasks.front());
+            workers_[victim]->tasks.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    queued_--;
+    run_(task);
+    return true;
+}
+
+void ThreadPool::run_(Task &task) {
+    try {
+        task.fn();
+    } catch (...) {
+        std::lock_guard lock(task.group->errorMutex_);
+        if (!task.group->error_) {
+            task.group->error_ = std::current_exception();
+        }
+    }
+
+    task.group->pending_--;
+}
+
+void ThreadPool::work_(std::size_t self) {
+    currentPool   = this;
+    currentWorker = self;
+
+    while (true) {
+        if (try_run_one_(self)) {
+            continue;
+        }
+
+        std::unique_lock lock(sleepMutex_);
+        wake_.wait(lock, [this] { return stop_ || queued_ > 0; });
+        if (stop_) {
+            return;
+        }
+    }
+}
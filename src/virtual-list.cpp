@@ -0,0 +1,138 @@
+// Glarens - GUI Framework.
+//
+// Virtualized list node implementation.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/virtual-list.hpp"
+#include "glarens/math.hpp"
+#include "glarens/node.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+static Vec2 direction_axis(Direction dir) noexcept {
+    switch (dir) {
+    case DIRECTION_UP: return Vec2(0.0f, -1.0f);
+    case DIRECTION_DOWN: return Vec2(0.0f, 1.0f);
+    case DIRECTION_LEFT: return Vec2(-1.0f, 0.0f);
+    case DIRECTION_RIGHT: return Vec2(1.0f, 0.0f);
+    }
+    return Vec2(0.0f, 1.0f);
+}
+
+static float view_extent(Direction dir, BoxMetric metric) noexcept {
+    Vec2 extent = abs(metric.bounds.extent);
+    return dir == DIRECTION_LEFT || dir == DIRECTION_RIGHT ? extent.x : extent.y;
+}
+
+void VirtualList::release_items_() {
+    for (const auto &item : items_) {
+        remove_child(item);
+    }
+    items_.clear();
+    spares_.clear();
+    firstIndex_ = 0;
+}
+
+void VirtualList::place_item_(Node &item, std::size_t index, std::size_t anchor, float fraction, float viewExtent) const {
+    float extent = itemExtent_.get();
+    Vec2  axis   = direction_axis(dir_.get());
+    Vec2  along  = abs(axis);
+    Vec2  across = Vec2(1.0f, 1.0f) - along;
+
+    // Item centers are laid out from the leading edge of the list, counted from the anchor so huge indices keep their precision
+    float slot   = index >= anchor ? static_cast<float>(index - anchor) : -static_cast<float>(anchor - index);
+    float offset = -viewExtent * 0.5f + (slot + 0.5f) * extent - fraction;
+
+    const BoxModel &model = item.get_model();
+    if (model.pos == axis * offset && model.size == along * extent && model.scale == across) {
+        return;
+    }
+
+    auto edit   = item.edit_model();
+    edit->pos   = axis * offset;
+    edit->size  = along * extent;
+    edit->scale = across;
+}
+
+void VirtualList::set_item_proto(std::shared_ptr<Node> proto) {
+    release_items_();
+    itemProto_    = std::move(proto);
+    itemsVersion_ = next_param_version();
+    rebind_       = true;
+}
+
+double VirtualList::get_max_scroll() const noexcept {
+    double content = static_cast<double>(itemCount_.get()) * itemExtent_.get();
+    return std::max(content - view_extent(dir_.get(), get_t_metric()), 0.0);
+}
+
+void VirtualList::refresh_items() {
+    float extent = itemExtent_.get();
+    if (!itemProto_ || !(extent > 0.0f)) {
+        release_items_();
+        return;
+    }
+
+    float       view     = view_extent(dir_.get(), get_t_metric());
+    std::size_t count    = itemCount_.get();
+    std::size_t overscan = overscan_.get();
+
+    scroll_ = std::clamp(scroll_, 0.0, get_max_scroll());
+
+    // Item at the leading edge and how far it is scrolled past
+    std::size_t anchor   = static_cast<std::size_t>(scroll_ / extent);
+    float       fraction = static_cast<float>(scroll_ - static_cast<double>(anchor) * extent);
+
+    std::size_t first = std::min(anchor > overscan ? anchor - overscan : 0, count);
+    std::size_t last  = static_cast<std::size_t>(std::ceil((scroll_ + view) / extent));
+    last              = std::min(last + overscan, count);
+
+    // Keep items still in range at their new slots, recycle the rest
+    std::vector<std::shared_ptr<Node>> items(last - first);
+    for (std::size_t slot = 0; slot < items_.size(); slot++) {
+        std::size_t index = firstIndex_ + slot;
+        if (index >= first && index < last) {
+            items[index - first] = std::move(items_[slot]);
+        } else {
+            remove_child(items_[slot]);
+            spares_.push_back(std::move(items_[slot]));
+        }
+    }
+
+    for (std::size_t slot = 0; slot < items.size(); slot++) {
+        auto &item  = items[slot];
+        bool  fresh = !item;
+
+        if (fresh) {
+            if (!spares_.empty()) {
+                item = std::move(spares_.back());
+                spares_.pop_back();
+            } else {
+                item = itemProto_->clone();
+            }
+            insert_child(item);
+        }
+
+        if ((fresh || rebind_) && bind_) {
+            bind_(*item, first + slot);
+        }
+
+        place_item_(*item, first + slot, anchor, fraction, view);
+    }
+
+    // Spares never need to outnumber the items in view
+    if (spares_.size() > items.size()) {
+        spares_.resize(items.size());
+    }
+
+    items_      = std::move(items);
+    firstIndex_ = first;
+    rebind_     = false;
+}
@@ -0,0 +1,118 @@
+// Glarens - GUI Framework.
+//
+// Flat node storage tests.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/glarens.hpp" // IWYU pragma: export
+#include "doctest/doctest.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+TEST_CASE("Arena is laid out in depth-first order") {
+    auto root = Node::create();
+    auto a    = root->create_child();
+    auto a1   = a->create_child();
+    auto b    = root->create_child();
+
+    NodeArena arena;
+    arena.build(root);
+
+    REQUIRE(arena.size() == 4);
+    CHECK(arena.get_nodes()[0] == root.get());
+    CHECK(arena.get_nodes()[1] == a.get());
+    CHECK(arena.get_nodes()[2] == a1.get());
+    CHECK(arena.get_nodes()[3] == b.get());
+
+    CHECK(arena.get_parents()[2] == 1);
+    CHECK(arena.get_first_children()[0] == 1);
+    CHECK(arena.get_next_siblings()[1] == 3);
+    CHECK(arena.get_next_siblings()[3] == NodeArena::NONE);
+    CHECK(arena.get_subtree_sizes()[0] == 4);
+    CHECK(arena.get_subtree_sizes()[1] == 2);
+}
+
+TEST_CASE("Arena layout matches the node layout pass") {
+    auto root = Node::create();
+
+    BoxModel rootModel;
+    rootModel.size = Vec2(640.0f, 480.0f);
+    root->set_model(rootModel);
+
+    for (int i = 0; i < 8; i++) {
+        auto child = root->create_child();
+
+        BoxModel model;
+        model.scale  = Vec2(0.1f * i, 0.5f);
+        model.anchor = Vec2(-0.5f + 0.1f * i, 0.0f);
+        child->set_model(model);
+
+        Transformation t;
+        t.rotate = 0.1f * i;
+        t.scale  = Vec2(1.0f + 0.1f * i);
+        child->set_t_stack({t});
+    }
+
+    root->flush_layout();
+
+    NodeArena arena;
+    arena.build(root);
+    arena.layout(LayoutContext::capture());
+
+    for (std::size_t i = 0; i < arena.size(); i++) {
+        CHECK(arena.get_t_metrics()[i] == arena.get_nodes()[i]->get_t_metric());
+    }
+}
+
+TEST_CASE("Arena runs layouts before their children") {
+    auto root = Node::create();
+
+    BoxModel rootModel;
+    rootModel.size = Vec2(400.0f, 100.0f);
+    root->set_model(rootModel);
+
+    // The layout fills its parent, so its items only change with the root
+    auto layout = root->create_child<FlexLayout>();
+    layout->set_model(BoxModel(Vec2(), Vec2(), Vec2(), Vec2(), Vec2(1.0f, 1.0f)));
+
+    std::vector<std::shared_ptr<Node>> items;
+    for (int i = 0; i < 2; i++) {
+        auto weight = FlexItem::create();
+        weight->set_weight(1.0f);
+        weight->set_wrap_weight(1.0f);
+
+        auto item = layout->create_child();
+        item->set_context(weight);
+        items.push_back(item);
+    }
+
+    NodeArena arena;
+    arena.build(root);
+    arena.layout(LayoutContext::capture());
+    arena.commit();
+
+    CHECK(items[0]->get_t_metric().bounds == Rect(Vec2(-100.0f, 0.0f), Vec2(200.0f, 100.0f)));
+    CHECK(items[1]->get_t_metric().bounds == Rect(Vec2(100.0f, 0.0f), Vec2(200.0f, 100.0f)));
+
+    rootModel.size = Vec2(200.0f, 100.0f);
+    root->set_model(rootModel);
+
+    arena.update_models();
+    arena.layout(LayoutContext::capture());
+    arena.commit();
+
+    CHECK(items[0]->get_t_metric().bounds == Rect(Vec2(-50.0f, 0.0f), Vec2(100.0f, 100.0f)));
+    CHECK(items[1]->get_t_metric().bounds == Rect(Vec2(50.0f, 0.0f), Vec2(100.0f, 100.0f)));
+
+    // Nothing is left for the node layout pass
+    for (std::size_t i = 0; i < arena.size(); i++) {
+        CHECK(arena.get_t_metrics()[i] == arena.get_nodes()[i]->get_t_metric());
+    }
+    std::uint64_t version = items[0]->get_model_version();
+    root->flush_layout();
+    CHECK(items[0]->get_model_version() == version);
+    CHECK(items[0]->get_t_metric().bounds.extent == Vec2(100.0f, 100.0f));
+}
@@ -0,0 +1,180 @@
+// Glarens - GUI Framework.
+//
+// Node context tests.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/glarens.hpp" // IWYU pragma: export
+#include "doctest/doctest.h"
+#include <memory>
+
+class Theme : public Context {
+  public:
+    int value = 0;
+
+    static std::shared_ptr<Theme> create(int value) {
+        auto theme   = std::shared_ptr<Theme>(new Theme);
+        theme->value = value;
+        return theme;
+    }
+
+    std::shared_ptr<Context> clone() override {
+        return create(value);
+    }
+
+    void sync(const std::shared_ptr<Context> &proto) override {
+        value = std::static_pointer_cast<Theme>(proto)->value;
+    }
+};
+
+class Focus : public Context {
+  public:
+    static std::shared_ptr<Focus> create() {
+        return std::shared_ptr<Focus>(new Focus);
+    }
+
+    std::shared_ptr<Context> clone() override {
+        return create();
+    }
+
+    void sync(const std::shared_ptr<Context> &) override {}
+};
+
+TEST_CASE("Contexts are stored per type") {
+    auto node = Node::create();
+
+    CHECK_FALSE(node->has_context<Theme>());
+    CHECK(node->get_context<Theme>() == nullptr);
+
+    node->set_context(Theme::create(7));
+    node->set_context(Focus::create());
+
+    CHECK(context_id<Theme>() != context_id<Focus>());
+    REQUIRE(node->get_context<Theme>() != nullptr);
+    CHECK(node->get_context<Theme>()->value == 7);
+    CHECK(node->has_context<Focus>());
+
+    node->reset_context<Theme>();
+    CHECK_FALSE(node->has_context<Theme>());
+    CHECK(node->has_context<Focus>());
+}
+
+TEST_CASE("Contexts are found in ancestors and descendants") {
+    auto root  = Node::create();
+    auto mid   = root->create_child();
+    auto leaf  = mid->create_child();
+    auto other = root->create_child();
+
+    root->set_context(Theme::create(1));
+    leaf->set_context(Focus::create());
+
+    REQUIRE(leaf->get_context_in_ancestor<Theme>() != nullptr);
+    CHECK(leaf->get_context_in_ancestor<Theme>()->value == 1);
+    CHECK_FALSE(root->has_context_in_ancestor<Theme>());
+
+    CHECK(root->has_context_in_descendant<Focus>());
+    CHECK(root->get_context_in_descendant<Focus>() == leaf->get_context<Focus>());
+    CHECK_FALSE(other->has_context_in_descendant<Focus>());
+}
+
+TEST_CASE("Contexts are cloned with their node") {
+    auto proto = Node::create();
+    proto->set_context(Theme::create(3));
+
+    auto clone = proto->clone();
+    REQUIRE(clone->get_context<Theme>() != nullptr);
+    CHECK(clone->get_context<Theme>() != proto->get_context<Theme>());
+
+    proto->get_context<Theme>()->value = 4;
+    proto->sync_clones();
+    CHECK(clone->get_context<Theme>()->value == 4);
+}
+
+TEST_CASE("Inherited contexts follow changes to ancestors") {
+    auto root = Node::create();
+    auto mid  = root->create_child();
+    auto leaf = mid->create_child();
+
+    root->set_context(Theme::create(1));
+    REQUIRE(leaf->get_context_in_ancestor<Theme>() != nullptr);
+    CHECK(leaf->get_context_in_ancestor<Theme>()->value == 1);
+
+    mid->set_context(Theme::create(2));
+    CHECK(leaf->get_context_in_ancestor<Theme>()->value == 2);
+
+    mid->reset_context<Theme>();
+    CHECK(leaf->get_context_in_ancestor<Theme>()->value == 1);
+
+    auto other = Node::create();
+    other->set_context(Theme::create(5));
+    mid->remove_child(leaf);
+    CHECK(leaf->get_context_in_ancestor<Theme>() == nullptr);
+
+    other->insert_child(leaf);
+    CHECK(leaf->get_context_in_ancestor<Theme>()->value == 5);
+}
+
+TEST_CASE("Inherited contexts are invalidated below the change only") {
+    auto root  = Node::create();
+    auto mid   = root->create_child();
+    auto left  = mid->create_child();
+    auto other = root->create_child();
+    auto right = other->create_child();
+
+    root->set_context(Theme::create(1));
+    mid->set_context(Theme::create(2));
+    CHECK(left->get_context_in_ancestor<Theme>()->value == 2);
+    CHECK(right->get_context_in_ancestor<Theme>()->value == 1);
+
+    // The holder in between shadows the change for its subtree
+    root->set_context(Theme::create(3));
+    CHECK(left->get_context_in_ancestor<Theme>()->value == 2);
+    CHECK(right->get_context_in_ancestor<Theme>()->value == 3);
+
+    mid->reset_context<Theme>();
+    CHECK(left->get_context_in_ancestor<Theme>()->value == 3);
+
+    // Moving a subtree leaves lookups elsewhere alone
+    mid->remove_child(left);
+    other->insert_child(left);
+    other->set_context(Theme::create(4));
+    CHECK(left->get_context_in_ancestor<Theme>()->value == 4);
+    CHECK(right->get_context_in_ancestor<Theme>()->value == 4);
+    CHECK(mid->get_context_in_ancestor<Theme>()->value == 3);
+}
+
+TEST_CASE("Descendant context queries only visit holding subtrees") {
+    auto root  = Node::create();
+    auto left  = root->create_child();
+    auto right = root->create_child();
+    auto deep  = right->create_child()->create_child();
+
+    CHECK_FALSE(root->has_context_in_descendant<Focus>());
+
+    deep->set_context(Focus::create());
+    left->set_context(Focus::create());
+    CHECK(root->has_context_in_descendant<Focus>());
+    CHECK(root->count_context_in_descendant<Focus>() == 2);
+    CHECK(root->get_context_in_descendant<Focus>() == left->get_context<Focus>());
+    CHECK(right->get_context_in_descendant<Focus>() == deep->get_context<Focus>());
+
+    std::size_t visited = 0;
+    root->for_each_with_context<Focus>([&](Node &node, Focus &focus) {
+        CHECK(node.get_context<Focus>() == &focus);
+        visited++;
+    });
+    CHECK(visited == 2);
+
+    left->reset_context<Focus>();
+    CHECK(root->count_context_in_descendant<Focus>() == 1);
+
+    root->remove_child(right);
+    CHECK_FALSE(root->has_context_in_descendant<Focus>());
+    CHECK(right->has_context_in_descendant<Focus>());
+
+    auto copy = right->clone();
+    root->insert_child(copy);
+    CHECK(root->count_context_in_descendant<Focus>() == 1);
+}
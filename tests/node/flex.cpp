@@ -0,0 +1,119 @@
+// Glarens - GUI Framework.
+//
+// Flex layout tests.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/glarens.hpp" // IWYU pragma: export
+#include "doctest/doctest.h"
+#include <memory>
+#include <vector>
+
+static BoxModel sized_model(Vec2 size) {
+    BoxModel model;
+    model.size = size;
+    return model;
+}
+
+static std::shared_ptr<FlexItem> weighted_item(float weight) {
+    auto item = FlexItem::create();
+    item->set_weight(weight);
+    item->set_wrap_weight(1.0f);
+    return item;
+}
+
+TEST_CASE("Flex items share the free space by weight") {
+    auto layout = FlexLayout::create();
+    layout->set_model(sized_model(Vec2(300.0f, 100.0f)));
+
+    std::vector<std::shared_ptr<Node>> items;
+    for (int i = 0; i < 3; i++) {
+        auto item = layout->create_child();
+        item->set_context(weighted_item(i == 2 ? 2.0f : 1.0f));
+        items.push_back(item);
+    }
+
+    layout->flush_layout();
+    CHECK(items[0]->get_t_metric().bounds == Rect(Vec2(-112.5f, 0.0f), Vec2(75.0f, 100.0f)));
+    CHECK(items[1]->get_t_metric().bounds == Rect(Vec2(-37.5f, 0.0f), Vec2(75.0f, 100.0f)));
+    CHECK(items[2]->get_t_metric().bounds == Rect(Vec2(75.0f, 0.0f), Vec2(150.0f, 100.0f)));
+
+    // The basis is kept, not the written extent
+    std::uint64_t version = items[0]->get_model_version();
+    layout->flush_layout();
+    CHECK(items[0]->get_model_version() == version);
+
+    layout->set_model(sized_model(Vec2(100.0f, 100.0f)));
+    layout->flush_layout();
+    CHECK(items[0]->get_t_metric().bounds.extent == Vec2(25.0f, 100.0f));
+    CHECK(items[2]->get_t_metric().bounds.extent == Vec2(50.0f, 100.0f));
+
+    // Models given by others become the new basis
+    items[0]->set_model(sized_model(Vec2(40.0f, 0.0f)));
+    layout->flush_layout();
+    CHECK(items[0]->get_t_metric().bounds.extent == Vec2(55.0f, 100.0f));
+}
+
+TEST_CASE("Flex lines wrap, align and alternate") {
+    auto layout = FlexLayout::create();
+    layout->set_model(sized_model(Vec2(100.0f, 100.0f)));
+    layout->set_align(ALIGN_SPACE_BETWEEN);
+
+    std::vector<std::shared_ptr<Node>> items;
+    for (int i = 0; i < 5; i++) {
+        auto item = layout->create_child();
+        item->set_model(sized_model(Vec2(40.0f, 20.0f)));
+        items.push_back(item);
+    }
+
+    layout->flush_layout();
+    CHECK(items[0]->get_t_metric().bounds.center == Vec2(-30.0f, -40.0f));
+    CHECK(items[1]->get_t_metric().bounds.center == Vec2(30.0f, -40.0f));
+    CHECK(items[2]->get_t_metric().bounds.center == Vec2(-30.0f, -20.0f));
+    CHECK(items[4]->get_t_metric().bounds.center == Vec2(0.0f, 0.0f));
+
+    layout->set_alt_wrapping(true);
+    layout->set_wrap_align(ALIGN_SPACE_EQUALLY);
+    layout->flush_layout();
+    CHECK(items[0]->get_t_metric().bounds.center == Vec2(-30.0f, -30.0f));
+    CHECK(items[2]->get_t_metric().bounds.center == Vec2(30.0f, 0.0f));
+    CHECK(items[3]->get_t_metric().bounds.center == Vec2(-30.0f, 0.0f));
+    CHECK(items[4]->get_t_metric().bounds.center == Vec2(0.0f, 30.0f));
+
+    // Without wrapping, overflowing items start at the beginning
+    layout->set_wrapping(false);
+    layout->flush_layout();
+    CHECK(items[0]->get_t_metric().bounds.center == Vec2(-30.0f, 0.0f));
+    CHECK(items[4]->get_t_metric().bounds.center == Vec2(130.0f, 0.0f));
+}
+
+TEST_CASE("Flex items keep their basis and follow the alignment by default") {
+    auto layout = FlexLayout::create();
+    layout->set_model(sized_model(Vec2(100.0f, 100.0f)));
+
+    std::vector<std::shared_ptr<Node>> items;
+    for (int i = 0; i < 3; i++) {
+        auto item = layout->create_child();
+        item->set_model(sized_model(Vec2(20.0f, 20.0f)));
+        items.push_back(item);
+    }
+
+    layout->flush_layout();
+    CHECK(items[0]->get_t_metric().bounds == Rect(Vec2(-40.0f, -40.0f), Vec2(20.0f, 20.0f)));
+    CHECK(items[2]->get_t_metric().bounds.center == Vec2(0.0f, -40.0f));
+
+    layout->set_align(ALIGN_CENTER);
+    layout->set_wrap_align(ALIGN_END);
+    layout->flush_layout();
+    CHECK(items[0]->get_t_metric().bounds.center == Vec2(-20.0f, 40.0f));
+    CHECK(items[2]->get_t_metric().bounds.center == Vec2(20.0f, 40.0f));
+
+    // A weighted item takes the free space, leaving nothing to align
+    items[1]->set_context(weighted_item(1.0f));
+    layout->refresh_layout();
+    layout->flush_layout();
+    CHECK(items[0]->get_t_metric().bounds.center == Vec2(-40.0f, 0.0f));
+    CHECK(items[1]->get_t_metric().bounds.extent == Vec2(60.0f, 100.0f));
+}
@@ -0,0 +1,89 @@
+// Glarens - GUI Framework.
+//
+// Grid layout tests.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/glarens.hpp" // IWYU pragma: export
+#include "doctest/doctest.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+static BoxModel sized_model(Vec2 size) {
+    BoxModel model;
+    model.size = size;
+    return model;
+}
+
+TEST_CASE("Grid rows wrap items by their spans") {
+    auto grid = GridLayout::create();
+    grid->set_model(sized_model(Vec2(300.0f, 300.0f)));
+    grid->set_slots(3);
+
+    std::vector<std::shared_ptr<Node>> items;
+    for (int i = 0; i < 4; i++) {
+        items.push_back(grid->create_child());
+    }
+
+    auto wide = GridItem::create();
+    wide->set_x_span(2);
+    wide->set_y_weight(0.5f);
+    items[2]->set_context(wide);
+
+    grid->flush_layout();
+    CHECK(items[0]->get_t_metric().bounds == Rect(Vec2(-100.0f, -100.0f), Vec2(100.0f, 100.0f)));
+    CHECK(items[1]->get_t_metric().bounds == Rect(Vec2(0.0f, -100.0f), Vec2(100.0f, 100.0f)));
+    CHECK(items[2]->get_t_metric().bounds == Rect(Vec2(-50.0f, -25.0f), Vec2(200.0f, 50.0f)));
+    CHECK(items[3]->get_t_metric().bounds == Rect(Vec2(100.0f, 0.0f), Vec2(100.0f, 100.0f)));
+
+    wide->set_y_weight(1.0f);
+    wide->set_y_span(2);
+    grid->set_wrap_align(ALIGN_CENTER);
+    grid->flush_layout();
+    CHECK(items[2]->get_t_metric().bounds == Rect(Vec2(-50.0f, 50.0f), Vec2(200.0f, 200.0f)));
+}
+
+TEST_CASE("Masonry re-places only the items after a change") {
+    auto grid = GridLayout::create();
+    grid->set_model(sized_model(Vec2(200.0f, 200.0f)));
+    grid->set_slots(2);
+    grid->set_masonry(true);
+
+    std::vector<std::shared_ptr<Node>> items;
+    for (float height : {50.0f, 100.0f, 30.0f, 40.0f}) {
+        auto item = grid->create_child();
+        item->set_model(sized_model(Vec2(0.0f, height)));
+        items.push_back(item);
+    }
+
+    grid->flush_layout();
+    CHECK(items[0]->get_t_metric().bounds.center == Vec2(-50.0f, -75.0f));
+    CHECK(items[1]->get_t_metric().bounds.center == Vec2(50.0f, -50.0f));
+    CHECK(items[2]->get_t_metric().bounds.center == Vec2(-50.0f, -35.0f));
+    CHECK(items[3]->get_t_metric().bounds.center == Vec2(-50.0f, 0.0f));
+
+    std::vector<std::uint64_t> versions;
+    for (const auto &item : items) {
+        versions.push_back(item->get_model_version());
+    }
+
+    // Appending places the new item into the shortest slot
+    auto appended = grid->create_child();
+    appended->set_model(sized_model(Vec2(0.0f, 10.0f)));
+    grid->flush_layout();
+    CHECK(appended->get_t_metric().bounds.center == Vec2(50.0f, 5.0f));
+    for (std::size_t i = 0; i < items.size(); i++) {
+        CHECK(items[i]->get_model_version() == versions[i]);
+    }
+
+    // Removing shifts the items after it, the ones before stay
+    grid->remove_child(items[1]);
+    grid->flush_layout();
+    CHECK(items[0]->get_model_version() == versions[0]);
+    CHECK(items[2]->get_t_metric().bounds.center == Vec2(50.0f, -85.0f));
+    CHECK(items[3]->get_t_metric().bounds.center == Vec2(50.0f, -50.0f));
+    CHECK(appended->get_t_metric().bounds.center == Vec2(-50.0f, -45.0f));
+}
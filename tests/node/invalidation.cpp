@@ -0,0 +1,82 @@
+// Glarens - GUI Framework.
+//
+// Invalidation accounting tests.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/glarens.hpp" // IWYU pragma: export
+#include "doctest/doctest.h"
+#include <memory>
+#include <source_location>
+
+static BoxModel sized_model(Vec2 size) {
+    BoxModel model;
+    model.size = size;
+    return model;
+}
+
+TEST_CASE("Recomputes are attributed to the invalidated node") {
+    glarens_set_invalidation_tracking(true);
+
+    auto root  = Node::create();
+    auto panel = root->create_child();
+    for (int i = 0; i < 3; i++) {
+        panel->create_child()->set_model(BoxModel(Vec2(), Vec2(), Vec2(), Vec2(), Vec2(0.5f, 0.5f)));
+    }
+    root->flush_layout();
+    glarens_reset_invalidation_stats();
+
+    auto line = std::source_location::current().line() + 1;
+    panel->set_model(sized_model(Vec2(100.0f, 50.0f)));
+    root->flush_layout();
+
+    InvalidationStats stats = panel->get_invalidation_stats();
+    CHECK(stats.invalidations == 1);
+    CHECK(stats.recomputes == 1);
+    CHECK(stats.touched == 3);
+    CHECK(stats.reason == INVALIDATION_MODEL);
+    CHECK(stats.where.line() == line);
+    CHECK(root->get_invalidation_stats().recomputes == 0);
+
+    auto offenders = glarens_get_invalidation_offenders(2);
+    REQUIRE(offenders.size() == 2);
+    CHECK(offenders[0].node == panel);
+    CHECK(offenders[1].stats.recomputes == 1);
+
+    // Unchanged metrics stop the cascade
+    panel->refresh_metric();
+    root->flush_layout();
+    CHECK(panel->get_invalidation_stats().reason == INVALIDATION_REFRESH);
+    CHECK(panel->get_invalidation_stats().touched == 3);
+
+    root->debug();
+    glarens_set_invalidation_tracking(false);
+    glarens_reset_invalidation_stats();
+}
+
+TEST_CASE("Instantiated prototypes are accounted as inserts") {
+    glarens_set_invalidation_tracking(true);
+
+    auto proto = Node::create();
+    proto->create_child();
+
+    auto root = Node::create();
+    root->flush_layout();
+
+    auto line      = std::source_location::current().line() + 1;
+    auto instances = instantiate(proto, 3, root);
+
+    for (const auto &instance : instances) {
+        InvalidationStats stats = instance->get_invalidation_stats();
+        CHECK(stats.invalidations == 1);
+        CHECK(stats.reason == INVALIDATION_INSERT);
+        CHECK(stats.where.line() == line);
+    }
+    CHECK(root->get_subtree_size() == 7);
+    CHECK(root->get_dirty_children().size() == 3);
+
+    glarens_set_invalidation_tracking(false);
+    glarens_reset_invalidation_stats();
+}
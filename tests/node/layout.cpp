@@ -0,0 +1,287 @@
+// Glarens - GUI Framework.
+//
+// Node layout pass tests.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/glarens.hpp" // IWYU pragma: export
+#include "doctest/doctest.h"
+#include <memory>
+
+static BoxModel sized_model(Vec2 size) {
+    BoxModel model;
+    model.size = size;
+    return model;
+}
+
+TEST_CASE("Model changes are deferred until layout is flushed") {
+    auto root = Node::create();
+    root->set_model(sized_model(Vec2(100.0f, 50.0f)));
+
+    CHECK(root->get_t_metric().bounds.extent == Vec2(0.0f, 0.0f));
+
+    root->flush_layout();
+    CHECK(root->get_t_metric().bounds.extent == Vec2(100.0f, 50.0f));
+}
+
+TEST_CASE("Parent changes propagate to children on flush") {
+    auto root  = Node::create();
+    auto child = root->create_child();
+
+    root->set_model(sized_model(Vec2(200.0f, 100.0f)));
+
+    BoxModel childModel;
+    childModel.scale = Vec2(0.5f, 0.5f);
+    child->set_model(childModel);
+
+    root->flush_layout();
+    CHECK(child->get_t_metric().bounds.extent == Vec2(100.0f, 50.0f));
+
+    root->set_model(sized_model(Vec2(400.0f, 200.0f)));
+    root->flush_layout();
+    CHECK(child->get_t_metric().bounds.extent == Vec2(200.0f, 100.0f));
+}
+
+TEST_CASE("Transformation changes are applied on flush") {
+    auto root = Node::create();
+    root->set_model(sized_model(Vec2(10.0f, 10.0f)));
+
+    Transformation t;
+    t.offset = Vec2(5.0f, 0.0f);
+    root->set_t_stack({t});
+
+    root->flush_layout();
+    CHECK(root->get_m_metric().bounds.center == Vec2(0.0f, 0.0f));
+    CHECK(root->get_t_metric().bounds.center == Vec2(5.0f, 0.0f));
+}
+
+TEST_CASE("Absolute modeling uses the layout context viewport") {
+    LayoutContext context;
+    context.viewport = Vec2(800.0f, 600.0f);
+
+    BoxModel model;
+    model.scale         = Vec2(0.5f, 1.0f);
+    model.sizingRefMode = REF_MODE_ABSOLUTE;
+
+    BoxMetric metric = model_box(model, BoxMetric::screen_metric(LayoutContext()), context);
+    CHECK(metric.bounds.extent == Vec2(400.0f, 600.0f));
+}
+
+TEST_CASE("Composed transformation matches sequential transformation") {
+    LayoutContext context;
+    context.viewport = Vec2(800.0f, 600.0f);
+
+    BoxMetric parentMetric = BoxMetric::screen_metric(context);
+    BoxMetric metric{.bounds = Rect(Vec2(120.0f, 80.0f), Vec2(60.0f, 40.0f)), .rotation = 0.0f};
+
+    TStack tStack(3);
+    tStack[0].offset         = Vec2(10.0f, -4.0f);
+    tStack[0].rotate         = 0.3f;
+    tStack[1].scale          = Vec2(1.5f, -0.5f);
+    tStack[1].originFloating = Vec2(0.5f, 0.5f);
+    tStack[2].rotate         = -1.2f;
+    tStack[2].originRefMode  = REF_MODE_ABSOLUTE;
+    tStack[2].originAnchor   = Vec2(0.25f, 0.0f);
+
+    BoxMetric expected = transform_box(metric, tStack, parentMetric, context);
+    BoxMetric actual   = apply_transform(metric, compose_transform(tStack, metric.bounds.extent, parentMetric, context));
+
+    CHECK(actual.bounds.center.x == doctest::Approx(expected.bounds.center.x));
+    CHECK(actual.bounds.center.y == doctest::Approx(expected.bounds.center.y));
+    CHECK(actual.bounds.extent.x == doctest::Approx(expected.bounds.extent.x));
+    CHECK(actual.bounds.extent.y == doctest::Approx(expected.bounds.extent.y));
+    CHECK(actual.rotation == doctest::Approx(expected.rotation));
+}
+
+TEST_CASE("Hit testing follows the transformed metric") {
+    auto root = Node::create();
+    root->set_model(sized_model(Vec2(100.0f, 10.0f)));
+
+    Transformation t;
+    t.rotate = 3.14159265f / 2.0f;
+    root->set_t_stack({t});
+    root->flush_layout();
+
+    CHECK(root->hit_test(Vec2(0.0f, 40.0f)));
+    CHECK_FALSE(root->hit_test(Vec2(40.0f, 0.0f)));
+}
+
+TEST_CASE("Lazy transformation moves children without re-modeling them") {
+    auto root  = Node::create();
+    auto panel = root->create_child();
+    auto child = panel->create_child();
+
+    root->set_model(sized_model(Vec2(800.0f, 600.0f)));
+    panel->set_model(sized_model(Vec2(200.0f, 100.0f)));
+    panel->set_lazy_transform(true);
+
+    BoxModel childModel;
+    childModel.scale = Vec2(0.5f, 0.5f);
+    child->set_model(childModel);
+
+    root->debug();
+    BoxMetric before = child->get_t_metric();
+
+    Transformation t;
+    t.offset = Vec2(30.0f, 0.0f);
+    panel->set_t_stack({t});
+    root->debug();
+
+    CHECK(child->get_t_metric() == before);
+    CHECK(child->get_world_metric().bounds.center == Vec2(30.0f, 0.0f));
+    CHECK(child->hit_test(Vec2(70.0f, 0.0f)));
+    CHECK_FALSE(child->hit_test(Vec2(-30.0f, 0.0f)));
+}
+
+TEST_CASE("In-place edits invalidate once they go out of scope") {
+    auto root = Node::create();
+    root->set_model(sized_model(Vec2(10.0f, 10.0f)));
+    root->flush_layout();
+
+    {
+        auto model  = root->edit_model();
+        model->size = Vec2(20.0f, 30.0f);
+        model->pos  = Vec2(5.0f, 5.0f);
+    }
+
+    {
+        auto tStack = root->edit_t_stack();
+        tStack->emplace_back().offset = Vec2(1.0f, 1.0f);
+    }
+
+    CHECK(root->get_model().size == Vec2(20.0f, 30.0f));
+
+    root->flush_layout();
+    CHECK(root->get_t_metric().bounds == Rect(Vec2(6.0f, 6.0f), Vec2(20.0f, 30.0f)));
+}
+
+TEST_CASE("Clones follow prototype changes on sync") {
+    auto proto = Node::create();
+    proto->set_model(sized_model(Vec2(10.0f, 10.0f)));
+
+    auto clone = proto->clone();
+    clone->flush_layout();
+    CHECK(clone->get_t_metric().bounds.extent == Vec2(10.0f, 10.0f));
+
+    proto->set_model(sized_model(Vec2(20.0f, 10.0f)));
+    proto->sync_clones();
+    clone->flush_layout();
+    CHECK(clone->get_t_metric().bounds.extent == Vec2(20.0f, 10.0f));
+
+    clone->set_model(sized_model(Vec2(5.0f, 5.0f)));
+    proto->edit_model()->scale.x *= 2.0f;
+    proto->sync_clones();
+    clone->flush_layout();
+    CHECK(clone->get_t_metric().bounds.extent == Vec2(5.0f, 5.0f));
+}
+
+/// Counts the synchronizations it receives from its prototype
+class SyncCounter : public Node {
+  protected:
+    SyncCounter() = default;
+
+  public:
+    int syncs = 0;
+
+    static std::shared_ptr<SyncCounter> create() {
+        return std::shared_ptr<SyncCounter>(new SyncCounter);
+    }
+
+    std::shared_ptr<Node> recreate() const override {
+        return std::shared_ptr<SyncCounter>(new SyncCounter);
+    }
+
+    void sync(const std::shared_ptr<Node> &proto) override {
+        syncs++;
+        Node::sync(proto);
+    }
+};
+
+TEST_CASE("Clones are not visited while the prototype is unchanged") {
+    auto proto = SyncCounter::create();
+    proto->set_model(sized_model(Vec2(10.0f, 10.0f)));
+    proto->set_context(FlexItem::create());
+
+    auto first  = std::static_pointer_cast<SyncCounter>(proto->clone());
+    auto second = std::static_pointer_cast<SyncCounter>(proto->clone());
+    proto->sync_clones();
+    int syncs = first->syncs;
+
+    proto->sync_clones();
+    proto->sync_clones();
+    CHECK(first->syncs == syncs);
+    CHECK(second->syncs == syncs);
+
+    proto->get_context<FlexItem>()->set_weight(2.0f);
+    proto->sync_clones();
+    CHECK(first->syncs == syncs + 1);
+
+    auto third = std::static_pointer_cast<SyncCounter>(proto->clone());
+    proto->sync_clones();
+    CHECK(third->syncs == 1);
+
+    proto->set_model(sized_model(Vec2(20.0f, 10.0f)));
+    proto->sync_clones();
+    CHECK(first->syncs == syncs + 2);
+    CHECK(third->syncs == 2);
+    CHECK(second->get_model().size == Vec2(20.0f, 10.0f));
+}
+
+TEST_CASE("Expired clones are dropped even while the prototype is unchanged") {
+    auto proto = Node::create();
+    proto->set_model(sized_model(Vec2(10.0f, 10.0f)));
+
+    auto kept = proto->clone();
+    proto->sync_clones();
+
+    for (int i = 0; i < 100; i++) {
+        auto dropped = proto->clone();
+    }
+    CHECK(proto->get_clone_count() == 101);
+
+    proto->sync_clones();
+    CHECK(proto->get_clone_count() == 1);
+}
+
+TEST_CASE("Parameters only resynchronize after the source changes") {
+    Param<int> source = 1;
+    Param<int> target;
+
+    CHECK(target.sync(source));
+    CHECK(target.get() == 1);
+    CHECK_FALSE(target.sync(source));
+
+    source.edit() = 2;
+    source.touch();
+    CHECK(target.sync(source));
+    CHECK(target.get() == 2);
+
+    target.set(3);
+    source.set(4);
+    CHECK_FALSE(target.sync(source));
+    target.clear();
+    CHECK(target.get() == 4);
+}
+
+TEST_CASE("Instantiated prototypes are attached and laid out together") {
+    auto proto = Node::create();
+    proto->set_model(sized_model(Vec2(10.0f, 10.0f)));
+    proto->create_child();
+
+    auto root      = Node::create();
+    auto instances = instantiate(proto, 100, root);
+
+    REQUIRE(instances.size() == 100);
+    CHECK(root->get_subtree_size() == 201);
+    CHECK(root->has_child(instances[42]));
+
+    root->flush_layout();
+    CHECK(instances[99]->get_t_metric().bounds.extent == Vec2(10.0f, 10.0f));
+
+    proto->set_model(sized_model(Vec2(20.0f, 10.0f)));
+    proto->sync_clones();
+    root->flush_layout();
+    CHECK(instances[0]->get_t_metric().bounds.extent == Vec2(20.0f, 10.0f));
+}
@@ -0,0 +1,152 @@
+// Glarens - GUI Framework.
+//
+// Parallel layout tests.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/glarens.hpp" // IWYU pragma: export
+#include "doctest/doctest.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+class Palette : public Context {
+  public:
+    int value = 0;
+
+    static std::shared_ptr<Palette> create(int value) {
+        auto palette   = std::shared_ptr<Palette>(new Palette);
+        palette->value = value;
+        return palette;
+    }
+
+    std::shared_ptr<Context> clone() override {
+        return create(value);
+    }
+
+    void sync(const std::shared_ptr<Context> &proto) override {
+        value = std::static_pointer_cast<Palette>(proto)->value;
+    }
+};
+
+/// Looks up the inherited palette while its children are laid out
+class Probe : public Node {
+  protected:
+    Probe() = default;
+
+  public:
+    mutable int seen = 0;
+
+    static std::shared_ptr<Probe> create() {
+        return std::shared_ptr<Probe>(new Probe);
+    }
+
+    std::shared_ptr<Node> recreate() const override {
+        return std::shared_ptr<Probe>(new Probe);
+    }
+
+    void on_model(const LayoutContext &) const override {
+        auto palette = get_context_in_ancestor<Palette>();
+        seen         = palette ? palette->value : 0;
+    }
+};
+
+static std::shared_ptr<Node> build_tree(int depth, int fanout) {
+    auto root = Node::create();
+
+    BoxModel rootModel;
+    rootModel.size = Vec2(1280.0f, 720.0f);
+    root->set_model(rootModel);
+
+    std::function<void(const std::shared_ptr<Node> &, int)> grow = [&](const std::shared_ptr<Node> &node, int level) {
+        if (level == depth) {
+            return;
+        }
+
+        for (int i = 0; i < fanout; i++) {
+            auto child = node->create_child();
+
+            BoxModel model;
+            model.scale  = Vec2(1.0f / fanout, 0.9f);
+            model.anchor = Vec2(-0.5f + (i + 0.5f) / fanout, 0.0f);
+            child->set_model(model);
+
+            Transformation t;
+            t.rotate = 0.05f * i;
+            t.offset = Vec2(level, i);
+            child->set_t_stack({t});
+
+            grow(child, level + 1);
+        }
+    };
+
+    grow(root, 0);
+    return root;
+}
+
+static void collect(const std::shared_ptr<Node> &root, std::vector<BoxMetric> &metrics) {
+    NodeArena arena;
+    arena.build(root);
+    for (const Node *node : arena.get_nodes()) {
+        metrics.push_back(node->get_t_metric());
+    }
+}
+
+TEST_CASE("Parallel layout matches serial layout") {
+    auto serial = build_tree(4, 6);
+    serial->flush_layout();
+
+    glarens_set_layout_threads(4);
+    glarens_set_layout_threshold(8);
+
+    auto parallel = build_tree(4, 6);
+    parallel->flush_layout();
+
+    glarens_set_layout_threads(0);
+
+    std::vector<BoxMetric> serialMetrics, parallelMetrics;
+    collect(serial, serialMetrics);
+    collect(parallel, parallelMetrics);
+
+    REQUIRE(serialMetrics.size() == parallelMetrics.size());
+    CHECK(serial->get_subtree_size() == serialMetrics.size());
+
+    bool identical = true;
+    for (std::size_t i = 0; i < serialMetrics.size(); i++) {
+        identical = identical && serialMetrics[i] == parallelMetrics[i];
+    }
+    CHECK(identical);
+}
+
+TEST_CASE("Parallel layout looks up inherited contexts") {
+    auto root = Node::create();
+    root->set_context(Palette::create(7));
+
+    std::vector<std::shared_ptr<Probe>> probes;
+    for (int i = 0; i < 8; i++) {
+        auto branch = root->create_child();
+        for (int j = 0; j < 8; j++) {
+            auto probe = Probe::create();
+            branch->insert_child(probe);
+            probe->create_child();
+            probes.push_back(probe);
+        }
+    }
+
+    glarens_set_layout_threads(4);
+    glarens_set_layout_threshold(2);
+    root->flush_layout();
+    glarens_set_layout_threads(0);
+
+    bool found = true;
+    for (const auto &probe : probes) {
+        found = found && probe->seen == 7;
+    }
+    CHECK(found);
+
+    // Lookups made outside of parallel passes are cached as usual
+    root->set_context(Palette::create(8));
+    CHECK(probes[0]->get_context_in_ancestor<Palette>()->value == 8);
+}
@@ -0,0 +1,107 @@
+// Glarens - GUI Framework.
+//
+// Profiler tests.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/glarens.hpp" // IWYU pragma: export
+#include "doctest/doctest.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if GLARENS_PROFILER
+
+static std::string read_file(const char *path) {
+    std::ifstream     file(path);
+    std::stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+TEST_CASE("Profiler zones are written as a Chrome trace") {
+    glarens_clear_profile();
+    glarens_set_profiling(true, 2);
+
+    auto root  = Node::create();
+    auto panel = root->create_child();
+    auto leaf  = panel->create_child();
+    root->update();
+    root->debug();
+
+    glarens_set_profiling(false);
+
+    // Disabled zones are not recorded
+    auto deep = leaf->create_child();
+    deep->update();
+
+    const char *path = "glarens-profiler-test.json";
+    REQUIRE(glarens_write_trace(path));
+    std::string trace = read_file(path);
+    std::remove(path);
+
+    CHECK(trace.find("\"traceEvents\"") != std::string::npos);
+    CHECK(trace.find("\"name\": \"update\"") != std::string::npos);
+    CHECK(trace.find("\"name\": \"layout\"") != std::string::npos);
+    CHECK(trace.find("\"name\": \"debug\"") != std::string::npos);
+
+    // Root and panel zones of update and debug, and the root layout nested in debug, nothing below the depth limit
+    std::size_t zones = 0;
+    for (std::size_t at = trace.find("\"ph\""); at != std::string::npos; at = trace.find("\"ph\"", at + 1)) {
+        zones++;
+    }
+    CHECK(zones == 5);
+}
+
+TEST_CASE("Profiler rings of exited threads are reused and cleared") {
+    glarens_set_profiling(true);
+    std::thread([] { Node::create()->update(); }).join();
+    glarens_clear_profile();
+
+    for (int i = 0; i < 2; i++) {
+        std::thread([] { Node::create()->update(); }).join();
+    }
+
+    glarens_set_profiling(false);
+
+    const char *path = "glarens-profiler-threads.json";
+    REQUIRE(glarens_write_trace(path));
+    std::string trace = read_file(path);
+    std::remove(path);
+
+    // Only the zones since clearing, both threads recorded into the same ring
+    std::size_t zones = 0;
+    std::string tid;
+    bool        shared = true;
+    for (std::size_t at = trace.find("\"tid\": "); at != std::string::npos; at = trace.find("\"tid\": ", at + 1)) {
+        std::string current = trace.substr(at, trace.find(',', at) - at);
+        shared &= tid.empty() || current == tid;
+        tid = current;
+        zones++;
+    }
+    CHECK(zones == 2);
+    CHECK(shared);
+}
+
+TEST_CASE("Frame marks feed the frame-time histogram") {
+    glarens_clear_profile();
+    glarens_set_profiling(true);
+
+    for (int i = 0; i < 5; i++) {
+        glarens_mark_frame();
+    }
+
+    glarens_set_profiling(false);
+
+    FrameHistogram histogram = glarens_get_frame_histogram();
+    CHECK(histogram.frames == 4);
+    CHECK(histogram.counts[0] == 4);
+    CHECK(histogram.minMs <= histogram.p99Ms);
+    CHECK(histogram.p99Ms <= histogram.maxMs);
+}
+
+#endif
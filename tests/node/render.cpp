@@ -0,0 +1,279 @@
+// Glarens - GUI Framework.
+//
+// Node render traversal tests.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/glarens.hpp" // IWYU pragma: export
+#include "doctest/doctest.h"
+#include <SDL3/SDL_render.h>
+#include <SDL3/SDL_surface.h>
+#include <cstddef>
+#include <memory>
+
+class Counted : public Node {
+  protected:
+    Counted() = default;
+
+  public:
+    mutable int renders = 0;
+
+    static std::shared_ptr<Counted> create() {
+        return std::shared_ptr<Counted>(new Counted);
+    }
+
+    std::shared_ptr<Node> recreate() const override {
+        return create();
+    }
+
+    void pre_render() const override {
+        renders++;
+    }
+};
+
+/// Software renderer bound to the library for the duration of a test
+struct Headless {
+    SDL_Surface  *surface  = SDL_CreateSurface(640, 480, SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+
+    Headless() { glarens_init(nullptr, renderer); }
+
+    ~Headless() {
+        glarens_term();
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroySurface(surface);
+    }
+};
+
+static std::shared_ptr<Counted> placed_child(const std::shared_ptr<Node> &parent, Vec2 pos, Vec2 size) {
+    auto child = parent->create_child<Counted>();
+
+    BoxModel model;
+    model.pos  = pos;
+    model.size = size;
+    child->set_model(model);
+    return child;
+}
+
+TEST_CASE("Off-screen nodes are culled") {
+    Headless headless;
+
+    auto root    = Counted::create();
+    auto inside  = placed_child(root, Vec2(100.0f, 100.0f), Vec2(10.0f, 10.0f));
+    auto outside = placed_child(root, Vec2(1000.0f, 100.0f), Vec2(10.0f, 10.0f));
+    auto nested  = placed_child(outside, Vec2(-900.0f, 0.0f), Vec2(10.0f, 10.0f));
+
+    root->render();
+    CHECK(inside->renders == 1);
+    CHECK(outside->renders == 0);
+    CHECK(nested->renders == 1);
+
+    outside->childrenInside = true;
+    root->render();
+    CHECK(nested->renders == 1);
+
+    outside->enableCulling = false;
+    root->render();
+    CHECK(outside->renders == 1);
+}
+
+TEST_CASE("Debug rendering is submitted as one batch") {
+    Headless headless;
+
+    auto root = Counted::create();
+    for (int i = 0; i < 100; i++) {
+        placed_child(root, Vec2(i, i), Vec2(10.0f, 10.0f));
+    }
+
+    std::size_t submits = glarens_get_batch().get_submit_count();
+    root->debug();
+    CHECK(glarens_get_batch().get_submit_count() == submits + 1);
+    CHECK(glarens_get_batch().empty());
+}
+
+TEST_CASE("Batched rectangles follow rotation") {
+    RenderBatch batch;
+
+    BoxMetric metric;
+    metric.bounds   = Rect(Vec2(0.0f, 0.0f), Vec2(2.0f, 2.0f));
+    metric.rotation = 0.25f * 3.14159265f;
+    batch.fill_rect(metric, Color(0xFFFFFFFFu));
+
+    CHECK(batch.get_vertex_count() == 4);
+    CHECK(batch.get_index_count() == 6);
+
+    batch.stroke_rect(metric, Color(0xFFFFFFFFu));
+    batch.line(Vec2(0.0f, 0.0f), Vec2(10.0f, 0.0f), Color(0xFFFFFFFFu));
+    CHECK(batch.get_vertex_count() == 24);
+
+    batch.flush(nullptr);
+    CHECK(batch.empty());
+}
+
+class Painted : public Counted {
+  protected:
+    Painted() = default;
+
+  public:
+    static std::shared_ptr<Painted> create() {
+        return std::shared_ptr<Painted>(new Painted);
+    }
+
+    void pre_render() const override {
+        Counted::pre_render();
+        glarens_get_batch().fill_rect(get_world_metric(), Color(0xFF0000FFu));
+    }
+};
+
+TEST_CASE("Retained subtrees replay until invalidated") {
+    Headless headless;
+
+    auto root  = Counted::create();
+    auto panel = root->create_child<Painted>();
+    auto leaf  = panel->create_child<Painted>();
+
+    BoxModel model;
+    model.size = Vec2(50.0f, 50.0f);
+    leaf->set_model(model);
+
+    panel->retainRender = true;
+
+    root->render();
+    CHECK(leaf->renders == 1);
+
+    root->render();
+    root->render();
+    CHECK(panel->renders == 1);
+    CHECK(leaf->renders == 1);
+
+    model.size = Vec2(60.0f, 60.0f);
+    leaf->set_model(model);
+    root->render();
+    CHECK(panel->renders == 2);
+    CHECK(leaf->renders == 2);
+
+    leaf->invalidate_render();
+    root->render();
+    CHECK(leaf->renders == 3);
+
+    panel->create_child<Painted>();
+    root->render();
+    CHECK(panel->renders == 4);
+
+    root->render();
+    CHECK(panel->renders == 4);
+}
+
+TEST_CASE("Partial redraw only draws damaged regions") {
+    Headless headless;
+    glarens_set_partial_redraw(true);
+
+    auto root   = Counted::create();
+    auto clock  = placed_child(root, Vec2(100.0f, 100.0f), Vec2(20.0f, 20.0f));
+    auto banner = placed_child(root, Vec2(400.0f, 300.0f), Vec2(20.0f, 20.0f));
+
+    glarens_render(root, Color(0x000000FFu));
+    CHECK(clock->renders == 1);
+    CHECK(banner->renders == 1);
+
+    glarens_render(root, Color(0x000000FFu));
+    CHECK(clock->renders == 1);
+    CHECK(banner->renders == 1);
+
+    BoxModel model;
+    model.pos  = Vec2(100.0f, 100.0f);
+    model.size = Vec2(30.0f, 20.0f);
+    clock->set_model(model);
+
+    glarens_render(root, Color(0x000000FFu));
+    CHECK(clock->renders == 2);
+    CHECK(banner->renders == 1);
+
+    glarens_damage_all();
+    glarens_render(root, Color(0x000000FFu));
+    CHECK(banner->renders == 2);
+
+    // Instances inserted in bulk damage their regions like single inserts
+    auto proto = Counted::create();
+    BoxModel protoModel;
+    protoModel.pos  = Vec2(100.0f, 100.0f);
+    protoModel.size = Vec2(10.0f, 10.0f);
+    proto->set_model(protoModel);
+
+    auto instances = instantiate(proto, 2, root);
+    glarens_render(root, Color(0x000000FFu));
+    CHECK(std::static_pointer_cast<Counted>(instances[0])->renders == 1);
+    CHECK(std::static_pointer_cast<Counted>(instances[1])->renders == 1);
+    CHECK(clock->renders == 4);
+    CHECK(banner->renders == 2);
+
+    glarens_set_partial_redraw(false);
+}
+
+TEST_CASE("Layers render their contents once and composite the texture") {
+    Headless headless;
+
+    auto root  = Counted::create();
+    auto panel = placed_child(root, Vec2(100.0f, 100.0f), Vec2(64.0f, 32.0f));
+    auto leaf  = panel->create_child<Painted>();
+
+    panel->layer = true;
+    panel->set_lazy_transform(true);
+
+    root->render();
+    CHECK(leaf->renders == 1);
+    CHECK(glarens_get_layer_usage() == 64 * 32 * 4);
+
+    root->render();
+    CHECK(leaf->renders == 1);
+
+    Transformation t;
+    t.offset = Vec2(30.0f, 0.0f);
+    panel->set_t_stack({t});
+    root->render();
+    CHECK(leaf->renders == 1);
+
+    BoxModel model;
+    model.scale = Vec2(0.5f, 0.5f);
+    leaf->set_model(model);
+    root->render();
+    CHECK(leaf->renders == 2);
+
+    glarens_set_layer_budget(64 * 32 * 4 - 1);
+    CHECK(glarens_get_layer_usage() == 0);
+
+    root->render();
+    CHECK(leaf->renders == 3);
+    CHECK(glarens_get_layer_usage() == 0);
+
+    glarens_set_layer_budget(64 * 1024 * 1024);
+}
+
+TEST_CASE("Headless mode lays out against the virtual viewport") {
+    REQUIRE(glarens_init_headless(Vec2(320.0f, 200.0f)));
+    REQUIRE(glarens_get_headless_surface() != nullptr);
+
+    auto root  = Counted::create();
+    auto child = root->create_child<Painted>();
+
+    BoxModel model;
+    model.scale = Vec2(0.5f, 0.5f);
+    root->set_model(model);
+
+    root->render();
+    CHECK(root->get_t_metric().bounds == Rect(Vec2(160.0f, 100.0f), Vec2(160.0f, 100.0f)));
+    CHECK(child->renders == 1);
+
+    model.pos   = Vec2(1000.0f, 0.0f);
+    model.scale = Vec2(0.0f, 0.0f);
+    model.size  = Vec2(10.0f, 10.0f);
+    child->set_model(model);
+
+    root->render();
+    CHECK(child->renders == 1);
+
+    glarens_term();
+    CHECK(glarens_get_headless_surface() == nullptr);
+}
@@ -0,0 +1,107 @@
+// Glarens - GUI Framework.
+//
+// Spatial index tests.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/glarens.hpp" // IWYU pragma: export
+#include "glarens/spatial-index.hpp"
+#include "doctest/doctest.h"
+#include <memory>
+#include <vector>
+
+static BoxModel placed_model(Vec2 pos, Vec2 size) {
+    BoxModel model;
+    model.pos  = pos;
+    model.size = size;
+    return model;
+}
+
+TEST_CASE("Spatial index picks the top-most node") {
+    auto root = Node::create();
+    root->set_model(placed_model(Vec2(0.0f, 0.0f), Vec2(1000.0f, 1000.0f)));
+
+    auto below = root->create_child();
+    below->set_model(placed_model(Vec2(0.0f, 0.0f), Vec2(100.0f, 100.0f)));
+
+    auto above = root->create_child();
+    above->set_model(placed_model(Vec2(20.0f, 0.0f), Vec2(100.0f, 100.0f)));
+
+    root->flush_layout();
+
+    SpatialIndex index(32.0f);
+    index.build(root);
+    CHECK(index.size() == 3);
+
+    Vec2 center = root->get_t_metric().bounds.center;
+    CHECK(index.pick(center) == above.get());
+    CHECK(index.pick(center - Vec2(45.0f, 0.0f)) == below.get());
+    CHECK(index.pick(center + Vec2(400.0f, 400.0f)) == root.get());
+    CHECK(index.pick(center + Vec2(600.0f, 0.0f)) == nullptr);
+
+    auto all = index.pick_all(center);
+    REQUIRE(all.size() == 3);
+    CHECK(all[0] == above.get());
+    CHECK(all[2] == root.get());
+
+    CHECK(index.query(Rect(center - Vec2(300.0f, 0.0f), Vec2(10.0f, 10.0f))).size() == 1);
+}
+
+TEST_CASE("Spatial index refits moved nodes") {
+    auto root = Node::create();
+    root->set_model(placed_model(Vec2(0.0f, 0.0f), Vec2(1000.0f, 1000.0f)));
+
+    auto child = root->create_child();
+    child->set_model(placed_model(Vec2(0.0f, 0.0f), Vec2(10.0f, 10.0f)));
+    root->flush_layout();
+
+    SpatialIndex index(16.0f);
+    index.build(root);
+
+    Vec2 center = root->get_t_metric().bounds.center;
+    CHECK(index.pick(center) == child.get());
+
+    child->set_model(placed_model(Vec2(200.0f, 0.0f), Vec2(10.0f, 10.0f)));
+    root->flush_layout();
+    CHECK(index.refit() == 1);
+
+    CHECK(index.pick(center) == root.get());
+    CHECK(index.pick(center + Vec2(200.0f, 0.0f)) == child.get());
+}
+
+TEST_CASE("Spatial index refits only the nodes that moved") {
+    auto root = Node::create();
+    root->set_model(placed_model(Vec2(0.0f, 0.0f), Vec2(1000.0f, 1000.0f)));
+
+    std::vector<std::shared_ptr<Node>> children;
+    for (int i = 0; i < 100; i++) {
+        auto child = root->create_child();
+        child->set_model(placed_model(Vec2(i * 5.0f, 0.0f), Vec2(4.0f, 4.0f)));
+        children.push_back(child);
+    }
+    root->flush_layout();
+
+    SpatialIndex index(16.0f);
+    index.build(root);
+    CHECK(index.refit() == 0);
+    CHECK(index.get_refit_checks() == 0);
+
+    children[42]->set_model(placed_model(Vec2(210.0f, 300.0f), Vec2(4.0f, 4.0f)));
+    root->flush_layout();
+    CHECK(index.refit() == 1);
+    CHECK(index.get_refit_checks() == 1);
+
+    Vec2 center = root->get_t_metric().bounds.center;
+    CHECK(index.pick(center + Vec2(210.0f, 300.0f)) == children[42].get());
+
+    // Moves recorded while another index was built are seen by both
+    SpatialIndex other(16.0f);
+    other.build(root);
+    children[7]->set_model(placed_model(Vec2(-300.0f, 0.0f), Vec2(4.0f, 4.0f)));
+    root->flush_layout();
+    CHECK(other.refit() == 1);
+    CHECK(index.refit() == 1);
+    CHECK(index.pick(center + Vec2(-300.0f, 0.0f)) == children[7].get());
+}
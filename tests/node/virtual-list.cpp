@@ -0,0 +1,102 @@
+// Glarens - GUI Framework.
+//
+// Virtualized list tests.
+//
+// Copyright (c) 2026 Anstro Pleuton.
+// This project is licensed under the terms of MIT license.
+// See LICENSE.md file in the project root for license text.
+
+#include "glarens/glarens.hpp" // IWYU pragma: export
+#include "glarens/virtual-list.hpp"
+#include "doctest/doctest.h"
+#include <cstddef>
+#include <memory>
+
+class Row : public Context {
+  public:
+    std::size_t index = 0;
+
+    static std::shared_ptr<Row> create() {
+        return std::shared_ptr<Row>(new Row);
+    }
+
+    std::shared_ptr<Context> clone() override {
+        return create();
+    }
+
+    void sync(const std::shared_ptr<Context> &) override {}
+};
+
+static std::shared_ptr<VirtualList> make_list(std::size_t count) {
+    auto list = VirtualList::create();
+
+    BoxModel model;
+    model.size = Vec2(100.0f, 100.0f);
+    list->set_model(model);
+
+    auto proto = Node::create();
+    proto->set_context(Row::create());
+
+    list->set_item_proto(proto);
+    list->set_item_extent(10.0f);
+    list->set_item_count(count);
+    list->set_overscan(1);
+    list->set_bind([](Node &item, std::size_t index) { item.get_context<Row>()->index = index; });
+
+    list->flush_layout();
+    list->update();
+    return list;
+}
+
+TEST_CASE("Virtual lists only materialize visible items") {
+    auto list = make_list(1'000'000);
+
+    CHECK(list->get_first_materialized() == 0);
+    CHECK(list->get_materialized_count() == 11);
+    CHECK(list->get_subtree_size() == 12);
+    REQUIRE(list->get_item(5) != nullptr);
+    CHECK(list->get_item(5)->get_context<Row>()->index == 5);
+
+    list->flush_layout();
+    CHECK(list->get_item(0)->get_t_metric().bounds.center.y == doctest::Approx(-45.0f));
+    CHECK(list->get_item(0)->get_t_metric().bounds.extent == Vec2(100.0f, 10.0f));
+}
+
+TEST_CASE("Virtual lists recycle items while scrolling") {
+    auto list = make_list(1'000'000);
+    auto kept = list->get_item(8);
+
+    list->set_scroll(55.0f);
+    list->update();
+
+    CHECK(list->get_first_materialized() == 4);
+    CHECK(list->get_materialized_count() == 13);
+    CHECK(list->get_item(8) == kept);
+    CHECK(list->get_item(16)->get_context<Row>()->index == 16);
+
+    list->set_scroll(1e12f);
+    list->update();
+    CHECK(list->get_scroll() == doctest::Approx(list->get_max_scroll()));
+    CHECK(list->get_first_materialized() + list->get_materialized_count() == 1'000'000);
+    CHECK(list->get_subtree_size() == 1 + list->get_materialized_count());
+}
+
+TEST_CASE("Virtual lists keep rows apart far into huge lists") {
+    auto list = make_list(5'000'000);
+
+    list->set_scroll(49'999'000.25);
+    list->update();
+    list->flush_layout();
+
+    REQUIRE(list->get_item(4'999'901) != nullptr);
+    float first  = list->get_item(4'999'900)->get_t_metric().bounds.center.y;
+    float second = list->get_item(4'999'901)->get_t_metric().bounds.center.y;
+    CHECK(first == doctest::Approx(-45.25f));
+    CHECK(second - first == doctest::Approx(10.0f));
+
+    // Steps far below the float resolution of the scroll distance still move the rows
+    list->set_scroll(list->get_scroll() + 0.5);
+    list->update();
+    list->flush_layout();
+    CHECK(list->get_item(4'999'900)->get_t_metric().bounds.center.y == doctest::Approx(-45.75f));
+}